@@ -11,8 +11,16 @@ Application::Application(const app_config_s &config)
       m_surface{m_instance.create_surface(m_window)},
       m_device{m_instance.handle(), m_surface},
       m_swapchain_uptr{create_swapchain()},
-      m_renderer{m_device, m_swapchain_uptr, m_logger->clone("renderer")},
-      m_scene{std::make_optional<scene::Scene>(m_window, m_device, m_swapchain_uptr)} {}
+      m_renderer{m_device,
+                 m_swapchain_uptr,
+                 config.vulkan.frames_in_flight,
+                 m_thread_pool,
+                 m_logger->clone("renderer")},
+      m_scene{std::make_optional<scene::Scene>(m_window,
+                                               m_device,
+                                               m_swapchain_uptr,
+                                               m_renderer.geometry_pool(),
+                                               m_thread_pool)} {}
 
 void Application::run() {
     while (!m_window.should_close()) {
@@ -33,7 +41,10 @@ std::unique_ptr<vulkan::Swapchain> Application::create_swapchain() {
 }
 
 void Application::recreate_swapchain() {
+    // the old swapchain's images and the descriptor sets referring to them may still be in use by frames in flight
+    m_device.device().waitIdle();
     m_swapchain_uptr = std::make_unique<vulkan::Swapchain>(m_device, m_window, m_surface, m_swapchain_uptr.get());
+    m_renderer.on_swapchain_recreated();
 }
 
 } // namespace sm::arcane
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include "app_config.hpp"
 #include "renderer.hpp"
 #include "scene/scene.hpp"
+#include "util/thread_pool.hpp"
 #include "vulkan/device.hpp"
 #include "vulkan/instance.hpp"
 #include "vulkan/swapchain.hpp"
@@ -45,6 +46,9 @@ public:
 private:
     std::shared_ptr<spdlog::logger> m_logger;
 
+    // engine-wide worker threads; declared first so it outlives everything that may have queued work on it
+    util::ThreadPool m_thread_pool;
+
     Window m_window;
 
     vulkan::Instance m_instance;
@@ -80,6 +80,14 @@ template<typename T>
             {-glm::dot(u, position), -glm::dot(v, position), -glm::dot(w, position), 1.0}};
 }
 
+template<typename T>
+[[nodiscard]] glm::tmat4x4<T, glm::qualifier::highp> remove_translation(
+        const glm::tmat4x4<T, glm::qualifier::highp> &view_matrix) noexcept {
+    auto rotation = view_matrix;
+    rotation[3] = {0.0, 0.0, 0.0, 1.0};
+    return rotation;
+}
+
 template<typename T>
 [[nodiscard]] glm::tmat4x4<T, glm::qualifier::highp> flip_projection_matrix(
         const glm::tmat4x4<T, glm::qualifier::highp> &updated_projection_matrix) noexcept {
@@ -103,23 +111,25 @@ template<typename T>
     auto matrices = camera_matrices_s<T>{};
     matrices.view_matrix = compute_view_matrix_YXZ(eye.transform.position, eye.transform.orientation);
     matrices.view_matrix_inverted = glm::inverse(matrices.view_matrix);
+    matrices.view_rotation_matrix = remove_translation(matrices.view_matrix);
     return matrices;
 }
 
 template<typename T>
 [[nodiscard]] camera_matrices_s<T> calculate_camera_matrices(const camera_eye_s<T> &eye,
                                                              const float aspect_ratio) noexcept {
-    // only   1/5, 2/5, 3/5   are filled
+    // only   1/6, 2/6, 3/6   are filled
     auto projection_matrices = calculate_camera_projection_matrix(eye, aspect_ratio);
 
-    // only   4/5, 5/5    are filled
+    // only   4/6, 5/6, 6/6   are filled
     auto view_matrices = calculate_camera_view_matrix(eye);
 
     return {.projection_matrix = projection_matrices.projection_matrix,
             .projection_matrix_flipped = projection_matrices.projection_matrix_flipped,
             .projection_matrix_inverted = projection_matrices.projection_matrix_inverted,
             .view_matrix = view_matrices.view_matrix,
-            .view_matrix_inverted = view_matrices.view_matrix_inverted};
+            .view_matrix_inverted = view_matrices.view_matrix_inverted,
+            .view_rotation_matrix = view_matrices.view_rotation_matrix};
 }
 
 [[nodiscard]] scene::viewpoint_s init_viewpoint() {
@@ -175,6 +185,7 @@ void Camera::update_projection_matrix() noexcept {
 void Camera::update_view_matrix() noexcept {
     m_matrices.view_matrix = compute_view_matrix_YXZ(m_eye_d.transform.position, m_eye_d.transform.orientation);
     m_matrices.view_matrix_inverted = glm::inverse(m_matrices.view_matrix);
+    m_matrices.view_rotation_matrix = remove_translation(m_matrices.view_matrix);
 }
 
 void Camera::update_eye_directions() noexcept {
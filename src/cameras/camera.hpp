@@ -26,6 +26,9 @@ struct camera_matrices_s {
     glm::tmat4x4<T, glm::qualifier::highp> projection_matrix_inverted;
     glm::tmat4x4<T, glm::qualifier::highp> view_matrix;
     glm::tmat4x4<T, glm::qualifier::highp> view_matrix_inverted;
+    // the view matrix without its translation: that of the same camera at the origin, which transforms positions
+    // relative to the camera (see `render::render_args_s::origin`)
+    glm::tmat4x4<T, glm::qualifier::highp> view_rotation_matrix;
 };
 
 struct camera_settings_s {
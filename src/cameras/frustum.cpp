@@ -0,0 +1,45 @@
+#include "frustum.hpp"
+
+#include <glm/geometric.hpp>
+
+namespace sm::arcane::cameras {
+
+namespace {
+
+[[nodiscard]] glm::f64vec4 row(const glm::f64mat4 &matrix, const int index) noexcept {
+    return {matrix[0][index], matrix[1][index], matrix[2][index], matrix[3][index]};
+}
+
+[[nodiscard]] glm::f32vec4 normalize_plane(const glm::f64vec4 &plane) noexcept {
+    return glm::f32vec4{plane / glm::length(glm::f64vec3{plane})};
+}
+
+} // namespace
+
+frustum_s frustum_s::from_view_projection(const glm::f64mat4 &view_projection) noexcept {
+    // Gribb & Hartmann: a clip-space point is inside when `-w <= x, y <= w` and `0 <= z <= w`
+    const auto x = row(view_projection, 0);
+    const auto y = row(view_projection, 1);
+    const auto z = row(view_projection, 2);
+    const auto w = row(view_projection, 3);
+
+    auto frustum = frustum_s{};
+    frustum.planes[left] = normalize_plane(w + x);
+    frustum.planes[right] = normalize_plane(w - x);
+    frustum.planes[bottom] = normalize_plane(w + y);
+    frustum.planes[top] = normalize_plane(w - y);
+    frustum.planes[near_clip] = normalize_plane(z);
+    frustum.planes[far_clip] = normalize_plane(w - z);
+    return frustum;
+}
+
+bool frustum_s::intersects_sphere(const glm::f32vec3 &center, const float radius) const noexcept {
+    for (const auto &plane : planes) {
+        if (glm::dot(glm::f32vec3{plane}, center) + plane.w < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace sm::arcane::cameras
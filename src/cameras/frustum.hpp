@@ -0,0 +1,29 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <array>
+
+#include <glm/fwd.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+namespace sm::arcane::cameras {
+
+// The six planes of a view frustum: `xyz` is the normal pointing inside, `w` the distance, so a point `p` is inside
+// a plane when `dot(xyz, p) + w >= 0`. The layout matches the `frustum_planes` of the cull view of `cull_objects.comp`
+struct frustum_s {
+    enum plane_e { left, right, bottom, top, near_clip, far_clip, count };
+
+    std::array<glm::f32vec4, plane_e::count> planes;
+
+    // extracts normalized planes from a view-projection matrix with the Vulkan [0, 1] depth range; the planes are in
+    // the space the matrix transforms from, i.e. world space for `projection * view`
+    [[nodiscard]] static frustum_s from_view_projection(const glm::f64mat4 &view_projection) noexcept;
+
+    [[nodiscard]] bool intersects_sphere(const glm::f32vec3 &center, float radius) const noexcept;
+};
+
+} // namespace sm::arcane::cameras
@@ -0,0 +1,127 @@
+#include "frustum_culling.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "cameras/frustum_culling_lanes.hpp"
+#include "os.h"
+#include "util/cpu_features.hpp"
+
+#if SM_ARCANE_ARCHITECTURE_X64 || defined(__SSE2__)
+    #define SM_ARCANE_FRUSTUM_CULLING_SSE2 1
+    #include <emmintrin.h>
+#else
+    #define SM_ARCANE_FRUSTUM_CULLING_SSE2 0
+#endif
+
+namespace sm::arcane::cameras {
+
+namespace {
+
+// large enough for a chunk to outweigh the cost of handing it to a worker, a multiple of every group width
+constexpr auto g_chunk_size = std::size_t{4096};
+
+#if SM_ARCANE_FRUSTUM_CULLING_SSE2
+
+struct sse2_lanes_s {
+    static constexpr auto width = std::size_t{4};
+
+    __m128 value = _mm_setzero_ps();
+
+    [[nodiscard]] static sse2_lanes_s broadcast(const float value) noexcept { return {_mm_set1_ps(value)}; }
+    [[nodiscard]] static sse2_lanes_s load(const float *values) noexcept { return {_mm_loadu_ps(values)}; }
+
+    friend sse2_lanes_s operator+(const sse2_lanes_s a, const sse2_lanes_s b) noexcept {
+        return {_mm_add_ps(a.value, b.value)};
+    }
+    friend sse2_lanes_s operator-(const sse2_lanes_s a, const sse2_lanes_s b) noexcept {
+        return {_mm_sub_ps(a.value, b.value)};
+    }
+    friend sse2_lanes_s operator*(const sse2_lanes_s a, const sse2_lanes_s b) noexcept {
+        return {_mm_mul_ps(a.value, b.value)};
+    }
+    friend unsigned less_mask(const sse2_lanes_s a, const sse2_lanes_s b) noexcept {
+        return static_cast<unsigned>(_mm_movemask_ps(_mm_cmplt_ps(a.value, b.value)));
+    }
+};
+
+#endif
+
+} // namespace
+
+std::size_t cull_spheres(const frustum_s &frustum,
+                         const sphere_batch_s &spheres,
+                         const std::span<std::uint32_t> visible) noexcept {
+    assert(visible.size() >= spheres.size() && "there must be room for every sphere to be visible");
+
+    auto progress = detail::cull_progress_s{};
+    switch (util::simd_level()) {
+        case util::simd_level_e::avx2: progress = detail::cull_spheres_avx2(frustum, spheres, visible); break;
+        case util::simd_level_e::sse2: progress = detail::cull_spheres_sse2(frustum, spheres, visible); break;
+        case util::simd_level_e::scalar: break;
+    }
+    return detail::cull_spheres_scalar(frustum, spheres, visible, progress);
+}
+
+std::size_t cull_spheres(const frustum_s &frustum,
+                         const sphere_batch_s &spheres,
+                         const std::span<std::uint32_t> visible,
+                         util::ThreadPool &thread_pool) {
+    assert(visible.size() >= spheres.size() && "there must be room for every sphere to be visible");
+
+    // every chunk writes its visible spheres to the part of `visible` matching its own spheres
+    const auto chunk_count = (spheres.size() + g_chunk_size - 1) / g_chunk_size;
+    auto visible_counts = std::vector<std::size_t>(chunk_count, 0);
+    thread_pool.parallel_for(chunk_count, [&](const std::size_t chunk) {
+        const auto first = chunk * g_chunk_size;
+        const auto count = std::min(g_chunk_size, spheres.size() - first);
+        const auto chunk_visible = visible.subspan(first, count);
+        visible_counts[chunk] = cull_spheres(frustum, spheres.subbatch(first, count), chunk_visible);
+        for (auto &index : chunk_visible.first(visible_counts[chunk])) {
+            index += static_cast<std::uint32_t>(first);
+        }
+    });
+
+    // then the chunks are moved together, in order: each one only ever moves towards the front, and stays in place
+    // while every chunk before it is fully visible, which `copy` doesn't allow for
+    auto visible_count = std::size_t{0};
+    for (auto chunk = std::size_t{0}; chunk < chunk_count; ++chunk) {
+        const auto chunk_visible = visible.subspan(chunk * g_chunk_size, visible_counts[chunk]);
+        if (visible_count != chunk * g_chunk_size) {
+            std::ranges::copy(chunk_visible, visible.begin() + static_cast<std::ptrdiff_t>(visible_count));
+        }
+        visible_count += chunk_visible.size();
+    }
+    return visible_count;
+}
+
+namespace detail {
+
+cull_progress_s cull_spheres_sse2(const frustum_s &frustum,
+                                  const sphere_batch_s &spheres,
+                                  const std::span<std::uint32_t> visible) noexcept {
+#if SM_ARCANE_FRUSTUM_CULLING_SSE2
+    return cull_groups<sse2_lanes_s>(frustum, spheres, visible);
+#else
+    return {};
+#endif
+}
+
+std::size_t cull_spheres_scalar(const frustum_s &frustum,
+                                const sphere_batch_s &spheres,
+                                const std::span<std::uint32_t> visible,
+                                cull_progress_s progress) noexcept {
+    for (auto i = progress.tested_count; i < spheres.size(); ++i) {
+        const auto center = glm::f32vec3{spheres.centers_x[i], spheres.centers_y[i], spheres.centers_z[i]};
+        if (frustum.intersects_sphere(center, spheres.radii[i])) {
+            visible[progress.visible_count++] = static_cast<std::uint32_t>(i);
+        }
+    }
+    return progress.visible_count;
+}
+
+} // namespace detail
+
+} // namespace sm::arcane::cameras
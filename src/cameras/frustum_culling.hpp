@@ -0,0 +1,67 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "cameras/frustum.hpp"
+#include "util/thread_pool.hpp"
+
+namespace sm::arcane::cameras {
+
+// The bounding spheres of a batch of objects, one array per component
+struct sphere_batch_s {
+    std::span<const float> centers_x;
+    std::span<const float> centers_y;
+    std::span<const float> centers_z;
+    std::span<const float> radii;
+
+    [[nodiscard]] std::size_t size() const noexcept { return radii.size(); }
+    [[nodiscard]] sphere_batch_s subbatch(std::size_t first, std::size_t count) const noexcept {
+        return {.centers_x = centers_x.subspan(first, count),
+                .centers_y = centers_y.subspan(first, count),
+                .centers_z = centers_z.subspan(first, count),
+                .radii = radii.subspan(first, count)};
+    }
+};
+
+// Writes the indices of the spheres intersecting `frustum` to `visible`, in increasing order, and returns how many
+// there are; `visible` has room for every sphere. The same test as `frustum_s::intersects_sphere`, for several spheres
+// per instruction with the widest instruction set of `util::simd_level`
+[[nodiscard]] std::size_t cull_spheres(const frustum_s &frustum,
+                                       const sphere_batch_s &spheres,
+                                       std::span<std::uint32_t> visible) noexcept;
+
+// the same, the spheres split into chunks culled in parallel by the workers of `thread_pool` and the calling thread
+[[nodiscard]] std::size_t cull_spheres(const frustum_s &frustum,
+                                       const sphere_batch_s &spheres,
+                                       std::span<std::uint32_t> visible,
+                                       util::ThreadPool &thread_pool);
+
+namespace detail {
+
+// how far a path of `cull_spheres` has got: the spheres [0, tested_count) are tested, `visible_count` of them visible
+struct cull_progress_s {
+    std::size_t tested_count = 0;
+    std::size_t visible_count = 0;
+};
+
+// The paths `cull_spheres` dispatches to. The vector ones test the batch a group of spheres at a time, leaving the rest
+// to the scalar one, which goes on from `progress` and returns the final visible count
+[[nodiscard]] cull_progress_s cull_spheres_sse2(const frustum_s &frustum,
+                                                const sphere_batch_s &spheres,
+                                                std::span<std::uint32_t> visible) noexcept;
+[[nodiscard]] cull_progress_s cull_spheres_avx2(const frustum_s &frustum,
+                                                const sphere_batch_s &spheres,
+                                                std::span<std::uint32_t> visible) noexcept;
+[[nodiscard]] std::size_t cull_spheres_scalar(const frustum_s &frustum,
+                                              const sphere_batch_s &spheres,
+                                              std::span<std::uint32_t> visible,
+                                              cull_progress_s progress) noexcept;
+
+} // namespace detail
+
+} // namespace sm::arcane::cameras
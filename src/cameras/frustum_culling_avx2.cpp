@@ -0,0 +1,65 @@
+// the AVX2 path of `cull_spheres`, in an AVX2 target region (see `os.h`): nothing there may run before
+// `util::simd_level` has reported AVX2 and FMA
+
+#include "frustum_culling.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <immintrin.h>
+
+#include "os.h"
+
+SM_ARCANE_BEGIN_AVX2_TARGET
+
+// after what it includes, so only its template is in the region
+#include "cameras/frustum_culling_lanes.hpp"
+
+namespace sm::arcane::cameras {
+
+namespace {
+
+struct avx2_lanes_s {
+    static constexpr auto width = std::size_t{8};
+
+    __m256 value = _mm256_setzero_ps();
+
+    [[nodiscard]] static avx2_lanes_s broadcast(const float value) noexcept { return {_mm256_set1_ps(value)}; }
+    [[nodiscard]] static avx2_lanes_s load(const float *values) noexcept { return {_mm256_loadu_ps(values)}; }
+};
+
+// not friends defined in the class, which GCC leaves out of the target region
+[[nodiscard]] avx2_lanes_s operator+(const avx2_lanes_s a, const avx2_lanes_s b) noexcept {
+    return {_mm256_add_ps(a.value, b.value)};
+}
+[[nodiscard]] avx2_lanes_s operator-(const avx2_lanes_s a, const avx2_lanes_s b) noexcept {
+    return {_mm256_sub_ps(a.value, b.value)};
+}
+[[nodiscard]] avx2_lanes_s operator*(const avx2_lanes_s a, const avx2_lanes_s b) noexcept {
+    return {_mm256_mul_ps(a.value, b.value)};
+}
+[[nodiscard]] unsigned less_mask(const avx2_lanes_s a, const avx2_lanes_s b) noexcept {
+    return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a.value, b.value, _CMP_LT_OQ)));
+}
+
+[[nodiscard]] detail::cull_progress_s cull_groups_avx2(const frustum_s &frustum,
+                                                       const sphere_batch_s &spheres,
+                                                       const std::span<std::uint32_t> visible) noexcept {
+    return detail::cull_groups<avx2_lanes_s>(frustum, spheres, visible);
+}
+
+} // namespace
+
+SM_ARCANE_END_AVX2_TARGET
+
+// declared out of the region, so defined out of it too: its declarations must agree on the target
+detail::cull_progress_s detail::cull_spheres_avx2(const frustum_s &frustum,
+                                                  const sphere_batch_s &spheres,
+                                                  const std::span<std::uint32_t> visible) noexcept {
+    return cull_groups_avx2(frustum, spheres, visible);
+}
+
+} // namespace sm::arcane::cameras
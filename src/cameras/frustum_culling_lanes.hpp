@@ -0,0 +1,53 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "cameras/frustum_culling.hpp"
+
+// The loop of `cull_spheres`, shared by its vector instruction sets. `V` holds one float per sphere of a group of
+// `V::width` spheres and provides `+`, `-`, `*`, `V::broadcast`, `V::load` from `V::width` unaligned floats, and
+// `less_mask`, the bit mask of the lanes where one operand is less than the other.
+//
+// Only ever instantiate it with a type local to the translation unit of its instruction set, and include it in the
+// AVX2 target region like `transform_lanes.hpp`
+namespace sm::arcane::cameras::detail {
+
+template<typename V>
+[[nodiscard]] cull_progress_s cull_groups(const frustum_s &frustum,
+                                          const sphere_batch_s &spheres,
+                                          const std::span<std::uint32_t> visible) noexcept {
+    auto planes = std::array<std::array<V, 4>, frustum_s::count>{};
+    for (auto plane = std::size_t{0}; plane < planes.size(); ++plane) {
+        const auto &[x, y, z, w] = frustum.planes[plane];
+        planes[plane] = {V::broadcast(x), V::broadcast(y), V::broadcast(z), V::broadcast(w)};
+    }
+
+    constexpr auto all_lanes = (1u << V::width) - 1u;
+    const auto zero = V::broadcast(0.0f);
+    auto progress = cull_progress_s{.tested_count = spheres.size() / V::width * V::width};
+    for (auto first = std::size_t{0}; first < progress.tested_count; first += V::width) {
+        const auto x = V::load(spheres.centers_x.data() + first);
+        const auto y = V::load(spheres.centers_y.data() + first);
+        const auto z = V::load(spheres.centers_z.data() + first);
+        const auto negative_radius = zero - V::load(spheres.radii.data() + first);
+
+        auto outside = 0u;
+        for (const auto &[plane_x, plane_y, plane_z, plane_w] : planes) {
+            outside |= less_mask(plane_x * x + plane_y * y + plane_z * z + plane_w, negative_radius);
+        }
+        // one iteration per visible sphere of the group, appended in the order of the lanes
+        for (auto lanes = ~outside & all_lanes; lanes != 0; lanes &= lanes - 1) {
+            visible[progress.visible_count++] = static_cast<std::uint32_t>(first + std::countr_zero(lanes));
+        }
+    }
+    return progress;
+}
+
+} // namespace sm::arcane::cameras::detail
@@ -0,0 +1,22 @@
+#include "lod_view.hpp"
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+namespace sm::arcane::cameras {
+
+lod_view_s lod_view_s::from_projection(const glm::f64vec3 &position,
+                                       const glm::f64mat4 &projection,
+                                       const std::uint32_t viewport_height) noexcept {
+    const auto pixels_per_unit = static_cast<double>(viewport_height) * glm::abs(projection[1][1]) / 2.0;
+    return {.position = glm::f32vec3{position},
+            .lod_scale = static_cast<float>(pixels_per_unit / static_cast<double>(g_max_lod_error_pixels))};
+}
+
+bool lod_view_s::accepts_error(const float error, const glm::f32vec3 &center, const float radius) const noexcept {
+    // inside the sphere, only an exact level is accurate enough
+    const auto distance = glm::max(glm::length(center - position) - radius, 0.0f);
+    return error * lod_scale <= distance;
+}
+
+} // namespace sm::arcane::cameras
@@ -0,0 +1,35 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <cstdint>
+
+#include <glm/fwd.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+namespace sm::arcane::cameras {
+
+// how far a simplified surface may be from the source one on screen before a finer level of detail is drawn
+inline constexpr auto g_max_lod_error_pixels = 1.0f;
+
+// What selecting a level of detail by its projected error needs from the camera of a frame. The layout of
+// `glm::f32vec4{position, lod_scale}` matches the last vector of the cull view of `cull_objects.comp`
+struct lod_view_s {
+    // in the space of the spheres it is compared with, e.g. relative to the camera (the origin then)
+    glm::f32vec3 position;
+    // pixels per world unit at distance 1, divided by `g_max_lod_error_pixels`: an error of `e` world units at
+    // distance `d` is acceptable when `e * lod_scale <= d`
+    float lod_scale = 0.0f;
+
+    // `projection` is a perspective one; its vertical scale is `1 / tan(fov / 2)`, whatever the sign of the y axis
+    [[nodiscard]] static lod_view_s from_projection(const glm::f64vec3 &position,
+                                                    const glm::f64mat4 &projection,
+                                                    std::uint32_t viewport_height) noexcept;
+
+    // whether an error of `error` world units is invisible at the distance of a sphere: its nearest point
+    [[nodiscard]] bool accepts_error(float error, const glm::f32vec3 &center, float radius) const noexcept;
+};
+
+} // namespace sm::arcane::cameras
@@ -29,7 +29,9 @@ struct quaternion_transform_components_s {
 
 } // namespace
 
-glm::f64mat4 transform_object_s::model_matrix() const noexcept {
+glm::f64mat4 model_matrix(const glm::f64vec3 &position,
+                          const glm::f32quat &orientation,
+                          const glm::f32vec3 &scale) noexcept {
     // clang-format off
     const auto [xx, yy, zz,
                 xy, xz, yz,
@@ -42,7 +44,7 @@ glm::f64mat4 transform_object_s::model_matrix() const noexcept {
             {position.x, position.y, position.z, 1.0}};
 }
 
-glm::f32mat3 transform_object_s::normal_matrix() const noexcept {
+glm::f32mat3 normal_matrix(const glm::f32quat &orientation, const glm::f32vec3 &scale) noexcept {
     // clang-format off
     const auto [xx, yy, zz,
                 xy, xz, yz,
@@ -62,4 +64,12 @@ glm::f32mat3 transform_object_s::normal_matrix() const noexcept {
              inv_scale.z * (1.0f - 2.0f * (xx + yy))}};
 }
 
+glm::f64mat4 transform_object_s::model_matrix() const noexcept {
+    return cameras::model_matrix(position, orientation, scale);
+}
+
+glm::f32mat3 transform_object_s::normal_matrix() const noexcept {
+    return cameras::normal_matrix(orientation, scale);
+}
+
 } // namespace sm::arcane::cameras
\ No newline at end of file
@@ -40,6 +40,13 @@ struct transform_s : pose_s {
 };
 
 
+// the matrices of a transform made of a translation, a rotation and a (possibly non-uniform) scale; the normal matrix
+// is the inverse transpose of the upper 3x3 of the model matrix
+[[nodiscard]] glm::f64mat4 model_matrix(const glm::f64vec3 &position,
+                                        const glm::f32quat &orientation,
+                                        const glm::f32vec3 &scale) noexcept;
+[[nodiscard]] glm::f32mat3 normal_matrix(const glm::f32quat &orientation, const glm::f32vec3 &scale) noexcept;
+
 struct transform_object_s : transform_s {
     glm::f32vec3 scale = g_default_scale;
 
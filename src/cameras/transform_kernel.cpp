@@ -0,0 +1,100 @@
+#include "transform_kernel.hpp"
+
+#include "cameras/transform_lanes.hpp"
+#include "os.h"
+#include "util/cpu_features.hpp"
+
+#if SM_ARCANE_ARCHITECTURE_X64 || defined(__SSE2__)
+    #define SM_ARCANE_TRANSFORM_KERNEL_SSE2 1
+    #include <emmintrin.h>
+#else
+    #define SM_ARCANE_TRANSFORM_KERNEL_SSE2 0
+#endif
+
+namespace sm::arcane::cameras {
+
+namespace {
+
+struct scalar_lanes_s {
+    static constexpr auto width = std::size_t{1};
+
+    float value = 0.0f;
+
+    [[nodiscard]] static scalar_lanes_s broadcast(const float value) noexcept { return {value}; }
+    [[nodiscard]] static scalar_lanes_s load(const float *values) noexcept { return {*values}; }
+    void store(float *values) const noexcept { *values = value; }
+
+    friend scalar_lanes_s operator+(const scalar_lanes_s a, const scalar_lanes_s b) noexcept {
+        return {a.value + b.value};
+    }
+    friend scalar_lanes_s operator-(const scalar_lanes_s a, const scalar_lanes_s b) noexcept {
+        return {a.value - b.value};
+    }
+    friend scalar_lanes_s operator*(const scalar_lanes_s a, const scalar_lanes_s b) noexcept {
+        return {a.value * b.value};
+    }
+    friend scalar_lanes_s operator/(const scalar_lanes_s a, const scalar_lanes_s b) noexcept {
+        return {a.value / b.value};
+    }
+};
+
+#if SM_ARCANE_TRANSFORM_KERNEL_SSE2
+
+struct sse2_lanes_s {
+    static constexpr auto width = std::size_t{4};
+
+    __m128 value = _mm_setzero_ps();
+
+    [[nodiscard]] static sse2_lanes_s broadcast(const float value) noexcept { return {_mm_set1_ps(value)}; }
+    [[nodiscard]] static sse2_lanes_s load(const float *values) noexcept { return {_mm_load_ps(values)}; }
+    void store(float *values) const noexcept { _mm_store_ps(values, value); }
+
+    friend sse2_lanes_s operator+(const sse2_lanes_s a, const sse2_lanes_s b) noexcept {
+        return {_mm_add_ps(a.value, b.value)};
+    }
+    friend sse2_lanes_s operator-(const sse2_lanes_s a, const sse2_lanes_s b) noexcept {
+        return {_mm_sub_ps(a.value, b.value)};
+    }
+    friend sse2_lanes_s operator*(const sse2_lanes_s a, const sse2_lanes_s b) noexcept {
+        return {_mm_mul_ps(a.value, b.value)};
+    }
+    friend sse2_lanes_s operator/(const sse2_lanes_s a, const sse2_lanes_s b) noexcept {
+        return {_mm_div_ps(a.value, b.value)};
+    }
+};
+
+#endif
+
+} // namespace
+
+void compute_matrices(const transform_batch_s &batch, const matrix_outputs_s &outputs) noexcept {
+    auto first = std::size_t{0};
+    switch (util::simd_level()) {
+        case util::simd_level_e::avx2: first = detail::compute_matrices_avx2(batch, outputs); break;
+        case util::simd_level_e::sse2: first = detail::compute_matrices_sse2(batch, outputs); break;
+        case util::simd_level_e::scalar: break;
+    }
+    detail::compute_matrices_scalar(batch, outputs, first);
+}
+
+namespace detail {
+
+std::size_t compute_matrices_sse2(const transform_batch_s &batch, const matrix_outputs_s &outputs) noexcept {
+#if SM_ARCANE_TRANSFORM_KERNEL_SSE2
+    return compute_groups<sse2_lanes_s>(batch, outputs);
+#else
+    return 0;
+#endif
+}
+
+void compute_matrices_scalar(const transform_batch_s &batch,
+                             const matrix_outputs_s &outputs,
+                             const std::size_t first) noexcept {
+    for (auto i = first; i < batch.size(); ++i) {
+        store_lanes(compute_lanes(load_lanes<scalar_lanes_s>(batch, i), batch.vertex_transform), outputs, i);
+    }
+}
+
+} // namespace detail
+
+} // namespace sm::arcane::cameras
@@ -0,0 +1,59 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <glm/fwd.hpp>
+#include <glm/gtx/quaternion.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+namespace sm::arcane::cameras {
+
+// The transforms of a batch of objects, one array per component. Object `i` of the batch is the element `indices[i]`
+// of every array, or the element `i` when `indices` is empty
+struct transform_batch_s {
+    std::span<const glm::f64vec3> positions;
+    std::span<const glm::f32quat> orientations;
+    std::span<const glm::f32vec3> scales;
+    std::span<const std::uint32_t> indices;
+
+    // subtracted from the positions in double precision, before they are narrowed to floats
+    glm::f64vec3 origin{0.0};
+    // applied to the vertices before the transforms: a uniform scale (`w`), then a translation (`xyz`), e.g. the
+    // dequantization of compact vertices (see `primitive_graphics::Mesh::vertex_transform`)
+    glm::f32vec4 vertex_transform{0.0f, 0.0f, 0.0f, 1.0f};
+
+    [[nodiscard]] std::size_t size() const noexcept { return indices.empty() ? positions.size() : indices.size(); }
+};
+
+// Where the matrices of object `i` of a batch go: the model matrix as a column-major float4x4 at
+// `model_matrices + i * stride`, the normal matrix as three float4 columns (the std430 layout of a `mat3`) at
+// `normal_matrices + i * stride`. One stride for both lets them be written straight into an array of instances
+struct matrix_outputs_s {
+    std::byte *model_matrices = nullptr;
+    std::byte *normal_matrices = nullptr;
+    std::size_t stride = 0;
+};
+
+// Computes the same matrices as `model_matrix` and `normal_matrix`, in single precision, for a whole batch at once:
+// several objects per instruction with the widest instruction set of `util::simd_level`
+void compute_matrices(const transform_batch_s &batch, const matrix_outputs_s &outputs) noexcept;
+
+namespace detail {
+
+// The paths `compute_matrices` dispatches to. The vector ones write the batch a group of objects at a time and return
+// how many objects they have written, leaving the rest to the scalar one, which writes [first, batch.size())
+std::size_t compute_matrices_sse2(const transform_batch_s &batch, const matrix_outputs_s &outputs) noexcept;
+std::size_t compute_matrices_avx2(const transform_batch_s &batch, const matrix_outputs_s &outputs) noexcept;
+void compute_matrices_scalar(const transform_batch_s &batch,
+                             const matrix_outputs_s &outputs,
+                             std::size_t first) noexcept;
+
+} // namespace detail
+
+} // namespace sm::arcane::cameras
@@ -0,0 +1,63 @@
+// the AVX2 path of `compute_matrices`, in an AVX2 target region (see `os.h`): nothing there may run before
+// `util::simd_level` has reported AVX2 and FMA
+
+#include "transform_kernel.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#include <immintrin.h>
+
+#include <glm/vec3.hpp>
+
+#include "os.h"
+
+SM_ARCANE_BEGIN_AVX2_TARGET
+
+// after what it includes, so only its templates are in the region
+#include "cameras/transform_lanes.hpp"
+
+namespace sm::arcane::cameras {
+
+namespace {
+
+struct avx2_lanes_s {
+    static constexpr auto width = std::size_t{8};
+
+    __m256 value = _mm256_setzero_ps();
+
+    [[nodiscard]] static avx2_lanes_s broadcast(const float value) noexcept { return {_mm256_set1_ps(value)}; }
+    [[nodiscard]] static avx2_lanes_s load(const float *values) noexcept { return {_mm256_load_ps(values)}; }
+    void store(float *values) const noexcept { _mm256_store_ps(values, value); }
+};
+
+// not friends defined in the class, which GCC leaves out of the target region
+[[nodiscard]] avx2_lanes_s operator+(const avx2_lanes_s a, const avx2_lanes_s b) noexcept {
+    return {_mm256_add_ps(a.value, b.value)};
+}
+[[nodiscard]] avx2_lanes_s operator-(const avx2_lanes_s a, const avx2_lanes_s b) noexcept {
+    return {_mm256_sub_ps(a.value, b.value)};
+}
+[[nodiscard]] avx2_lanes_s operator*(const avx2_lanes_s a, const avx2_lanes_s b) noexcept {
+    return {_mm256_mul_ps(a.value, b.value)};
+}
+[[nodiscard]] avx2_lanes_s operator/(const avx2_lanes_s a, const avx2_lanes_s b) noexcept {
+    return {_mm256_div_ps(a.value, b.value)};
+}
+
+[[nodiscard]] std::size_t compute_groups_avx2(const transform_batch_s &batch,
+                                              const matrix_outputs_s &outputs) noexcept {
+    return detail::compute_groups<avx2_lanes_s>(batch, outputs);
+}
+
+} // namespace
+
+SM_ARCANE_END_AVX2_TARGET
+
+// declared out of the region, so defined out of it too: its declarations must agree on the target
+std::size_t detail::compute_matrices_avx2(const transform_batch_s &batch, const matrix_outputs_s &outputs) noexcept {
+    return compute_groups_avx2(batch, outputs);
+}
+
+} // namespace sm::arcane::cameras
@@ -0,0 +1,153 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#include <glm/vec3.hpp>
+
+#include "cameras/transform_kernel.hpp"
+
+// The arithmetic of `compute_matrices`, shared by all of its instruction sets. `V` holds one float per object of a
+// group of `V::width` objects and provides `+`, `-`, `*`, `/`, `V::broadcast`, `V::load` and `store`, the last two
+// from and to `V::width` floats aligned to 64 bytes.
+//
+// Only ever instantiate these with a type local to the translation unit of its instruction set, so their
+// instantiations are never merged by the linker. The AVX2 path includes this header in its target region (see
+// `os.h`), after the headers included here, which compiles these templates, and only them, for AVX2
+namespace sm::arcane::cameras::detail {
+
+template<typename V>
+struct lane_transforms_t {
+    V px, py, pz;
+    V qx, qy, qz, qw;
+    V sx, sy, sz;
+};
+
+// the columns of the model matrix without their last row, always (0, 0, 0, 1), then the columns of the normal matrix
+template<typename V>
+struct lane_matrices_t {
+    std::array<V, 12> model;
+    std::array<V, 9> normal;
+};
+
+// gathers the objects [first, first + V::width) of the batch, one per lane
+template<typename V>
+[[nodiscard]] lane_transforms_t<V> load_lanes(const transform_batch_s &batch, const std::size_t first) noexcept {
+    alignas(64) auto lanes = std::array<std::array<float, V::width>, 10>{};
+    for (auto lane = std::size_t{0}; lane < V::width; ++lane) {
+        const auto index = batch.indices.empty() ? first + lane : std::size_t{batch.indices[first + lane]};
+        const auto position = glm::f32vec3{batch.positions[index] - batch.origin};
+        const auto &orientation = batch.orientations[index];
+        const auto &scale = batch.scales[index];
+        lanes[0][lane] = position.x;
+        lanes[1][lane] = position.y;
+        lanes[2][lane] = position.z;
+        lanes[3][lane] = orientation.x;
+        lanes[4][lane] = orientation.y;
+        lanes[5][lane] = orientation.z;
+        lanes[6][lane] = orientation.w;
+        lanes[7][lane] = scale.x;
+        lanes[8][lane] = scale.y;
+        lanes[9][lane] = scale.z;
+    }
+    return {.px = V::load(lanes[0].data()),
+            .py = V::load(lanes[1].data()),
+            .pz = V::load(lanes[2].data()),
+            .qx = V::load(lanes[3].data()),
+            .qy = V::load(lanes[4].data()),
+            .qz = V::load(lanes[5].data()),
+            .qw = V::load(lanes[6].data()),
+            .sx = V::load(lanes[7].data()),
+            .sy = V::load(lanes[8].data()),
+            .sz = V::load(lanes[9].data())};
+}
+
+// the same matrices as `model_matrix` and `normal_matrix`, the model matrix followed by `vertex_transform`
+template<typename V>
+[[nodiscard]] lane_matrices_t<V> compute_lanes(const lane_transforms_t<V> &transforms,
+                                               const glm::f32vec4 &vertex_transform) noexcept {
+    const auto &[px, py, pz, x, y, z, w, sx, sy, sz] = transforms;
+    const auto one = V::broadcast(1.0f);
+    const auto two = V::broadcast(2.0f);
+    const auto xx = x * x;
+    const auto yy = y * y;
+    const auto zz = z * z;
+    const auto xy = x * y;
+    const auto xz = x * z;
+    const auto yz = y * z;
+    const auto wx = w * x;
+    const auto wy = w * y;
+    const auto wz = w * z;
+
+    // clang-format off
+    const auto rotation = std::array{one - two * (yy + zz), two * (xy - wz), two * (xz + wy),
+                                     two * (xy + wz), one - two * (xx + zz), two * (yz - wx),
+                                     two * (xz - wy), two * (yz + wx), one - two * (xx + yy)};
+    // clang-format on
+    const auto scale = std::array{sx, sy, sz};
+    const auto inverse_scale = std::array{one / sx, one / sy, one / sz};
+    const auto vertex_scale = V::broadcast(vertex_transform.w);
+    const auto vertex_offset = std::array{V::broadcast(vertex_transform.x),
+                                          V::broadcast(vertex_transform.y),
+                                          V::broadcast(vertex_transform.z)};
+
+    auto matrices = lane_matrices_t<V>{};
+    auto translation = std::array{px, py, pz};
+    for (auto column = std::size_t{0}; column < 3; ++column) {
+        for (auto row = std::size_t{0}; row < 3; ++row) {
+            const auto element = rotation[3 * column + row] * scale[column];
+            translation[row] = translation[row] + element * vertex_offset[column];
+            matrices.model[3 * column + row] = element * vertex_scale;
+            matrices.normal[3 * column + row] = rotation[3 * column + row] * inverse_scale[column];
+        }
+    }
+    for (auto row = std::size_t{0}; row < 3; ++row) {
+        matrices.model[9 + row] = translation[row];
+    }
+    return matrices;
+}
+
+// scatters the matrices of the objects [first, first + V::width) to `outputs`
+template<typename V>
+void store_lanes(const lane_matrices_t<V> &matrices,
+                 const matrix_outputs_s &outputs,
+                 const std::size_t first) noexcept {
+    alignas(64) auto lanes = std::array<std::array<float, V::width>, 21>{};
+    for (auto i = std::size_t{0}; i < matrices.model.size(); ++i) {
+        matrices.model[i].store(lanes[i].data());
+    }
+    for (auto i = std::size_t{0}; i < matrices.normal.size(); ++i) {
+        matrices.normal[i].store(lanes[matrices.model.size() + i].data());
+    }
+
+    for (auto lane = std::size_t{0}; lane < V::width; ++lane) {
+        // clang-format off
+        const auto model_matrix = std::array{lanes[0][lane], lanes[1][lane], lanes[2][lane], 0.0f,
+                                             lanes[3][lane], lanes[4][lane], lanes[5][lane], 0.0f,
+                                             lanes[6][lane], lanes[7][lane], lanes[8][lane], 0.0f,
+                                             lanes[9][lane], lanes[10][lane], lanes[11][lane], 1.0f};
+        const auto normal_matrix = std::array{lanes[12][lane], lanes[13][lane], lanes[14][lane], 0.0f,
+                                              lanes[15][lane], lanes[16][lane], lanes[17][lane], 0.0f,
+                                              lanes[18][lane], lanes[19][lane], lanes[20][lane], 0.0f};
+        // clang-format on
+        const auto offset = (first + lane) * outputs.stride;
+        std::memcpy(outputs.model_matrices + offset, model_matrix.data(), sizeof(model_matrix));
+        std::memcpy(outputs.normal_matrices + offset, normal_matrix.data(), sizeof(normal_matrix));
+    }
+}
+
+// returns the number of objects written: every full group of the batch
+template<typename V>
+std::size_t compute_groups(const transform_batch_s &batch, const matrix_outputs_s &outputs) noexcept {
+    const auto written_count = batch.size() / V::width * V::width;
+    for (auto first = std::size_t{0}; first < written_count; first += V::width) {
+        store_lanes(compute_lanes(load_lanes<V>(batch, first), batch.vertex_transform), outputs, first);
+    }
+    return written_count;
+}
+
+} // namespace sm::arcane::cameras::detail
@@ -0,0 +1,41 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+// The bindless descriptor heap (`vulkan::BindlessHeap`), bound as set 1 of every pipeline.
+// Usage: `#include "common/shaders/bindless.glsl"` after enabling `GL_GOOGLE_include_directive`
+
+#ifndef SM_ARCANE_BINDLESS_GLSL
+#define SM_ARCANE_BINDLESS_GLSL
+
+#extension GL_EXT_nonuniform_qualifier : require
+
+#define SM_ARCANE_BINDLESS_SET 1
+#define SM_ARCANE_BINDLESS_STORAGE_BUFFER_BINDING 0
+#define SM_ARCANE_BINDLESS_SAMPLED_IMAGE_BINDING 1
+
+#define SM_ARCANE_INVALID_BINDLESS_ID 0xffffffffu
+
+// Declares a view of the storage buffer array with the element type `element_type`: the same binding may be aliased by
+// any number of views, e.g. `SM_ARCANE_BINDLESS_STORAGE_BUFFER(instances_s, instance_s)` followed by
+// `instances_s_array[nonuniformEXT(id)].items[i]`
+#define SM_ARCANE_BINDLESS_STORAGE_BUFFER(block_name, element_type)                                                    \
+    layout(set = SM_ARCANE_BINDLESS_SET, binding = SM_ARCANE_BINDLESS_STORAGE_BUFFER_BINDING, std430)                  \
+            readonly buffer block_name {                                                                               \
+        element_type items[];                                                                                          \
+    }                                                                                                                  \
+    block_name##_array[]
+
+// The same as `SM_ARCANE_BINDLESS_STORAGE_BUFFER`, but writable: for the compute passes producing per-frame data
+#define SM_ARCANE_BINDLESS_RW_STORAGE_BUFFER(block_name, element_type)                                                 \
+    layout(set = SM_ARCANE_BINDLESS_SET, binding = SM_ARCANE_BINDLESS_STORAGE_BUFFER_BINDING, std430)                  \
+            buffer block_name {                                                                                        \
+        element_type items[];                                                                                          \
+    }                                                                                                                  \
+    block_name##_array[]
+
+layout(set = SM_ARCANE_BINDLESS_SET, binding = SM_ARCANE_BINDLESS_SAMPLED_IMAGE_BINDING) uniform sampler2D
+        bindless_textures[];
+
+vec4 sample_bindless_texture(uint id, vec2 uv) { return texture(bindless_textures[nonuniformEXT(id)], uv); }
+
+#endif // SM_ARCANE_BINDLESS_GLSL
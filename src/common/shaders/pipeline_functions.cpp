@@ -7,35 +7,29 @@
 
 namespace sm::arcane::common::shaders {
 
-std::pair<vertex_data_t, fragment_data_t> read_spirv_files(const std::filesystem::path &file_name) {
+shader_data_t read_spirv_file(const std::filesystem::path &file_name) {
     static const auto spirv_dir_path = std::filesystem::path{SM_ARCANE_SPIRV_DIR_PATH};
-    static constexpr auto vert_extension = std::string_view{".vert.spv"};
-    static constexpr auto frag_extension = std::string_view{".frag.spv"};
-
-    const auto vert_spirv_src_file_path{spirv_dir_path / (file_name.string() + vert_extension.data())};
-    const auto frag_spirv_src_file_path{spirv_dir_path / (file_name.string() + frag_extension.data())};
-
-    static const auto read_file_to_vector = [](const std::filesystem::path &path) {
-        auto file = std::ifstream{path, std::ios::ate | std::ios::binary};
+    static constexpr auto spirv_extension = std::string_view{".spv"};
 
-        if (!file.is_open()) {
-            throw std::runtime_error{"Failed to open SPIR-V file!"};
-        }
+    const auto spirv_file_path = spirv_dir_path / (file_name.string() + spirv_extension.data());
 
-        const auto file_size = file.tellg();
-        auto buffer = shader_data_t(file_size);
+    auto file = std::ifstream{spirv_file_path, std::ios::ate | std::ios::binary};
+    if (!file.is_open()) {
+        throw std::runtime_error{"Failed to open SPIR-V file!"};
+    }
 
-        file.seekg(0);
-        file.read(buffer.data(), file_size);
-        file.close();
+    const auto file_size = file.tellg();
+    auto buffer = shader_data_t(file_size);
 
-        return buffer;
-    };
+    file.seekg(0);
+    file.read(buffer.data(), file_size);
+    file.close();
 
-    const auto vert_data = read_file_to_vector(vert_spirv_src_file_path);
-    const auto frag_data = read_file_to_vector(frag_spirv_src_file_path);
+    return buffer;
+}
 
-    return {vert_data, frag_data};
+std::pair<vertex_data_t, fragment_data_t> read_spirv_files(const std::filesystem::path &file_name) {
+    return {read_spirv_file(file_name.string() + ".vert"), read_spirv_file(file_name.string() + ".frag")};
 }
 
 vk::raii::ShaderModule create_shader_module(const vk::raii::Device &device, const std::vector<char> &code) noexcept {
@@ -26,6 +26,9 @@ using shader_data_t = std::vector<char>;
 using vertex_data_t = shader_data_t;
 using fragment_data_t = shader_data_t;
 
+// reads `<file_name>.spv` from the SPIR-V output directory, e.g. `read_spirv_file("draw_object.vert")`
+[[nodiscard]] shader_data_t read_spirv_file(const std::filesystem::path &file_name);
+
 [[nodiscard]] std::pair<vertex_data_t, fragment_data_t> read_spirv_files(const std::filesystem::path &file_name);
 
 [[nodiscard]] vk::raii::ShaderModule create_shader_module(const vk::raii::Device &device,
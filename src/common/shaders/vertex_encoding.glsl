@@ -0,0 +1,19 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+// The decoding side of `primitive_graphics::compact_vertex_s`.
+// Usage: `#include "common/shaders/vertex_encoding.glsl"` after enabling `GL_GOOGLE_include_directive`
+
+#ifndef SM_ARCANE_VERTEX_ENCODING_GLSL
+#define SM_ARCANE_VERTEX_ENCODING_GLSL
+
+// the inverse of `encode_octahedral` in `primitive_graphics/vertex_format.cpp`: `encoded` is in [-1, 1] (snorm)
+vec3 decode_octahedral(vec2 encoded) {
+    vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    if (normal.z < 0.0) {
+        normal.xy = (1.0 - abs(normal.yx)) * vec2(normal.x >= 0.0 ? 1.0 : -1.0, normal.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return normalize(normal);
+}
+
+#endif // SM_ARCANE_VERTEX_ENCODING_GLSL
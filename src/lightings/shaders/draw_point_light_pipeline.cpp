@@ -0,0 +1,18 @@
+#include "draw_point_light_pipeline.hpp"
+
+namespace sm::arcane::lightings::shaders {
+
+vulkan::graphics_pipeline_desc_s draw_point_light_pipeline_desc(const vk::PipelineLayout pipeline_layout,
+                                                                const vk::Format color_format,
+                                                                const vk::Format depth_format) {
+    // the billboard is generated in the vertex shader from `gl_VertexIndex`, so there is no vertex input
+    return {.vertex_shader = "draw_point_light.vert",
+            .fragment_shader = "draw_point_light.frag",
+            .layout = pipeline_layout,
+            .front_face = vk::FrontFace::eClockwise,
+            .depth_compare_op = vk::CompareOp::eLess,
+            .color_formats = {color_format},
+            .depth_format = depth_format};
+}
+
+} // namespace sm::arcane::lightings::shaders
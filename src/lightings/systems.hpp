@@ -13,26 +13,20 @@ namespace sm::arcane::lightings {
 class DrawPointLightSystem {
 public:
     struct resources_s {
-        shaders::DynamicDrawPointLightPipeline pipeline;
+        vulkan::pipeline_t pipeline;
 
         [[nodiscard]] static resources_s create(const render::pass_context_s &ctx) {
-            return {.pipeline = {ctx.device.device(),
-                                 ctx.global.descriptor_set_layout,
-                                 ctx.swapchain->color_format(),
-                                 ctx.swapchain->depth_format()}};
+            return {.pipeline = ctx.pipeline_registry.register_pipeline(
+                            shaders::draw_point_light_pipeline_desc(ctx.global.pipeline_layout,
+                                                                    ctx.swapchain->color_format(),
+                                                                    ctx.swapchain->depth_format()))};
         }
     };
 
     explicit DrawPointLightSystem(const render::pass_context_s &ctx) : m_resources{resources_s::create(ctx)} {}
 
     void render(const render::render_args_s &args) const {
-        args.command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, *m_resources.pipeline.handle());
-
-        args.command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-                                               *m_resources.pipeline.layout(),
-                                               0,
-                                               {args.global.descriptor_set},
-                                               nullptr);
+        args.command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, **m_resources.pipeline);
 
         args.command_buffer.draw(6, 1, 0, 0);
     }
@@ -3,40 +3,21 @@
 
 #pragma once
 
-#include <memory>
-#include <optional>
-
 #include <glm/fwd.hpp>
-#include <glm/gtx/quaternion.hpp>
-#include <glm/vec3.hpp>
-
-#include "cameras/transform.hpp"
-#include "primitive_graphics/mesh.hpp"
+#include <glm/mat3x4.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
 
 namespace sm::arcane::objects {
-class GameObject {
-public:
-    GameObject(const GameObject &) = delete;
-    GameObject &operator=(const GameObject &) = delete;
-    GameObject(GameObject &&) noexcept = default;
-    GameObject &operator=(GameObject &&) noexcept = default;
-
-    explicit GameObject(std::shared_ptr<primitive_graphics::Mesh> &&mesh);
-
-    void set_position(const glm::f64vec3 &position) noexcept;
-    void set_orientation(float degrees, const glm::f32vec3 &axis) noexcept;
-    void set_scale(float scale) noexcept;
-    void set_scale(const glm::f32vec3 &scale) noexcept;
-
-    [[nodiscard]] cameras::transform_object_s transform() const noexcept;
-    [[nodiscard]] glm::f32vec3 color() const noexcept;
-    [[nodiscard]] std::shared_ptr<primitive_graphics::Mesh> mesh() const noexcept;
-
-private:
-    std::shared_ptr<primitive_graphics::Mesh> m_mesh;
-    cameras::transform_object_s m_transform;
 
-    std::optional<glm::f32vec3> m_color;
+// One element of the instance array read by `draw_object_instanced.vert` (std430). The normal matrix is stored as
+// three vec4 columns, exactly as std430 lays out a `mat3`. Being 128 bytes, an array allocated with that alignment
+// can be indexed with `gl_InstanceIndex` from any offset of the buffer
+struct object_instance_s {
+    glm::f32mat4 model_matrix{1.0f};
+    glm::f32mat3x4 normal_matrix{1.0f};
+    glm::f32vec4 color{1.0f};
 };
+static_assert(sizeof(object_instance_s) == 128);
 
 } // namespace sm::arcane::objects
\ No newline at end of file
@@ -0,0 +1,144 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+// What `cull_objects.comp` and `cull_meshlets.comp` share: their input and output in the object buffer of the frame,
+// the draw buffer, the frame allocator buffer and the tables of the meshes, their push constants and the emission of
+// draw commands.
+// Usage: `#include "objects/shaders/cull_common.glsl"` after enabling `GL_GOOGLE_include_directive`
+
+#ifndef SM_ARCANE_CULL_COMMON_GLSL
+#define SM_ARCANE_CULL_COMMON_GLSL
+
+#include "common/shaders/bindless.glsl"
+
+// `objects::object_instance_s`
+struct object_instance_s {
+    mat4 model_matrix;
+    mat3 normal_matrix;
+    vec4 color;
+};
+
+// `objects::cull_batch_s`
+struct cull_batch_s {
+    vec4 bounding_sphere;
+    uint base_vertex;
+    uint draw_group;
+    uint first_index;
+    uint lod_count;
+    uint table_id;
+    uint first_table_element;
+    uint tests_cones;
+    uint padding[5];
+};
+
+// `primitive_graphics::mesh_table_lod_s`
+struct mesh_table_lod_s {
+    uint first_index;
+    uint index_count;
+    float error;
+    uint first_meshlet;
+    uint meshlet_count;
+    uint padding[3];
+};
+
+// `primitive_graphics::meshlet_s`
+struct meshlet_s {
+    vec3 center;
+    float radius;
+    uint cone;
+    uint first_index;
+    uint index_count;
+    uint vertex_count;
+};
+
+// `objects::cull_object_s`
+struct cull_object_s {
+    uint instance_index;
+    uint batch_index;
+};
+
+// `objects::cull_meshlet_object_s`
+struct cull_meshlet_object_s {
+    uint instance_index;
+    uint batch_index;
+    uint first_meshlet;
+    uint meshlet_count;
+};
+
+SM_ARCANE_BINDLESS_STORAGE_BUFFER(object_instances_s, object_instance_s);
+// `objects::cull_view_s`: the six frustum planes, then the camera position and the LOD scale
+SM_ARCANE_BINDLESS_STORAGE_BUFFER(cull_view_vectors_s, vec4);
+SM_ARCANE_BINDLESS_STORAGE_BUFFER(cull_batches_s, cull_batch_s);
+// the tables of the meshes, one per block of the geometry pool: the levels of a mesh, then its meshlets
+SM_ARCANE_BINDLESS_STORAGE_BUFFER(mesh_table_lods_s, mesh_table_lod_s);
+SM_ARCANE_BINDLESS_STORAGE_BUFFER(mesh_table_meshlets_s, meshlet_s);
+SM_ARCANE_BINDLESS_STORAGE_BUFFER(cull_objects_s, cull_object_s);
+SM_ARCANE_BINDLESS_RW_STORAGE_BUFFER(cull_meshlet_objects_s, cull_meshlet_object_s);
+// the draw commands, the draw groups and the meshlet dispatch, addressed in 32-bit words
+SM_ARCANE_BINDLESS_RW_STORAGE_BUFFER(draw_words_s, uint);
+
+// `objects::cull_push_constants_s`
+layout(push_constant) uniform push_s {
+    // the view, the batches, the draw groups and the meshlet dispatch
+    uint buffer_id;
+    // the instances, then the objects
+    uint object_buffer_id;
+    // the draw commands, then the meshlet objects
+    uint draw_buffer_id;
+    uint first_cull_view_vector;
+    uint first_cull_batch;
+    uint first_cull_object;
+    uint cull_object_count;
+    uint first_meshlet_object;
+    uint first_command_word;
+    // two words per group: the draw count, then the first command of the group
+    uint first_draw_group_word;
+    // a `VkDispatchIndirectCommand`, then the number of meshlet objects: the group count is that number, up to
+    // `max_meshlet_group_count`, then 1 and 1
+    uint meshlet_dispatch_word;
+    uint max_meshlet_group_count;
+}
+push;
+
+// the size of `VkDrawIndexedIndirectCommand` in words
+const uint g_command_word_count = 5;
+
+vec4 cull_view_vector(uint index) {
+    return cull_view_vectors_s_array[push.buffer_id].items[push.first_cull_view_vector + index];
+}
+
+// `xyz` is the camera position, `w` the LOD scale, see `cameras::lod_view_s`
+vec4 lod_view() { return cull_view_vector(6); }
+
+// relative to the camera, like the model matrices of the instances, see `cameras::frustum_s`
+bool is_visible(vec3 center, float radius) {
+    for (uint i = 0; i < 6; ++i) {
+        vec4 plane = cull_view_vector(i);
+        if (dot(plane.xyz, center) + plane.w < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// the largest scale of a model matrix, which any length of the mesh grows by
+float max_scale(mat4 model_matrix) {
+    return max(length(model_matrix[0].xyz), max(length(model_matrix[1].xyz), length(model_matrix[2].xyz)));
+}
+
+// Appends a command to the range of the batch's draw group, which is sized for every command its objects may emit.
+// The commands of a group may come from different meshes, levels of detail and meshlets of the same geometry block
+void emit_draw(cull_batch_s batch, uint index_count, uint first_index, uint instance_index) {
+    uint draw_group_word = push.first_draw_group_word + batch.draw_group * 2;
+    uint slot = atomicAdd(draw_words_s_array[push.buffer_id].items[draw_group_word], 1);
+    uint first_command = draw_words_s_array[push.buffer_id].items[draw_group_word + 1];
+    uint command_word = push.first_command_word + (first_command + slot) * g_command_word_count;
+
+    draw_words_s_array[push.draw_buffer_id].items[command_word + 0] = index_count;
+    draw_words_s_array[push.draw_buffer_id].items[command_word + 1] = 1;
+    draw_words_s_array[push.draw_buffer_id].items[command_word + 2] = first_index;
+    draw_words_s_array[push.draw_buffer_id].items[command_word + 3] = batch.base_vertex;
+    draw_words_s_array[push.draw_buffer_id].items[command_word + 4] = instance_index;
+}
+
+#endif // SM_ARCANE_CULL_COMMON_GLSL
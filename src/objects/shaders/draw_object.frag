@@ -19,12 +19,6 @@ layout(set = 0, binding = 0) uniform global_ubo_s {
 }
 global_ubo;
 
-layout(push_constant) uniform push_s {
-    mat4 model_matrix;
-    mat4 normal_matrix;
-}
-push;
-
 void main() {
     vec3 direction_to_light = global_ubo.light_position - fragment_position_world;
     float attenuation = 1.0 / dot(direction_to_light, direction_to_light);
@@ -21,17 +21,19 @@ layout(set = 0, binding = 0) uniform global_ubo_s {
 }
 global_ubo;
 
-void main() {
-    // vec4 position_world = push.model_matrix * vec4(vertex_position, 1.0); TODO: need to support `push constants`
-
-    mat4 model_matrix = mat4(1.0);
-    model_matrix[3][2] = 5.0;
+// `primitive_graphics::Mesh::simple_push_consts_data_s`
+layout(push_constant) uniform push_s {
+    mat4 model_matrix;
+    mat4 normal_matrix;
+}
+push;
 
-    vec4 position_world = model_matrix * vec4(vertex_position, 1.0);
+void main() {
+    vec4 position_world = push.model_matrix * vec4(vertex_position, 1.0);
 
     gl_Position = global_ubo.projection * global_ubo.view * position_world;
 
     fragment_position_world = position_world.xyz;
     fragment_color = vertex_color;
-    // fragment_normal_color = normalize(mat3(push.normal_matrix) * vertex_normal);
+    fragment_normal_color = normalize(mat3(push.normal_matrix) * vertex_normal);
 }
\ No newline at end of file
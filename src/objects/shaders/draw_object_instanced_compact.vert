@@ -0,0 +1,54 @@
+#version 450
+
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+#extension GL_GOOGLE_include_directive : require
+
+#include "common/shaders/bindless.glsl"
+#include "common/shaders/vertex_encoding.glsl"
+
+// `primitive_graphics::compact_vertex_s`: the position is dequantized by the model matrix of the instance
+layout(location = 0) in vec3 vertex_position;
+layout(location = 1) in vec4 vertex_color;
+layout(location = 2) in vec2 vertex_normal;
+
+layout(location = 0) out vec3 fragment_position_world;
+layout(location = 1) out vec4 fragment_color;
+layout(location = 2) out vec3 fragment_normal_color;
+
+layout(set = 0, binding = 0) uniform global_ubo_s {
+    mat4 projection;
+    mat4 view;
+    mat4 inverse_view;
+    vec4 ambient_light_color;
+    vec4 light_color;
+    vec3 light_position;
+}
+global_ubo;
+
+// `objects::object_instance_s`
+struct object_instance_s {
+    mat4 model_matrix;
+    mat3 normal_matrix;
+    vec4 color;
+};
+
+SM_ARCANE_BINDLESS_STORAGE_BUFFER(object_instances_s, object_instance_s);
+
+layout(push_constant) uniform push_s {
+    // the bindless id of the buffer holding the instance array; `gl_InstanceIndex` already includes `firstInstance`
+    uint instance_buffer_id;
+}
+push;
+
+void main() {
+    object_instance_s instance = object_instances_s_array[push.instance_buffer_id].items[gl_InstanceIndex];
+
+    vec4 position_world = instance.model_matrix * vec4(vertex_position, 1.0);
+
+    gl_Position = global_ubo.projection * global_ubo.view * position_world;
+
+    fragment_position_world = position_world.xyz;
+    fragment_color = vertex_color * instance.color;
+    fragment_normal_color = normalize(instance.normal_matrix * decode_octahedral(vertex_normal));
+}
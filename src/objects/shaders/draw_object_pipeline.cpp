@@ -1 +1,47 @@
-#include "draw_object_pipeline.hpp"
\ No newline at end of file
+#include "draw_object_pipeline.hpp"
+
+#include <utility>
+
+namespace sm::arcane::objects::shaders {
+
+vulkan::graphics_pipeline_desc_s draw_object_pipeline_desc(const vk::PipelineLayout pipeline_layout,
+                                                           const vk::Format color_format,
+                                                           const vk::Format depth_format) {
+    auto vertex_input = primitive_graphics::vertex_input(primitive_graphics::vertex_format_e::full);
+    return {.vertex_shader = "draw_object.vert",
+            .fragment_shader = "draw_object.frag",
+            .layout = pipeline_layout,
+            .vertex_bindings = std::move(vertex_input.bindings),
+            .vertex_attributes = std::move(vertex_input.attributes),
+            .cull_mode = g_draw_object_cull_mode,
+            .color_formats = {color_format},
+            .depth_format = depth_format};
+}
+
+vulkan::graphics_pipeline_desc_s draw_object_instanced_pipeline_desc(
+        const vk::PipelineLayout pipeline_layout,
+        const vk::Format color_format,
+        const vk::Format depth_format,
+        const primitive_graphics::vertex_format_e vertex_format) {
+    auto desc = draw_object_pipeline_desc(pipeline_layout, color_format, depth_format);
+    if (vertex_format == primitive_graphics::vertex_format_e::full) {
+        desc.vertex_shader = "draw_object_instanced.vert";
+        return desc;
+    }
+
+    auto vertex_input = primitive_graphics::vertex_input(vertex_format);
+    desc.vertex_shader = "draw_object_instanced_compact.vert";
+    desc.vertex_bindings = std::move(vertex_input.bindings);
+    desc.vertex_attributes = std::move(vertex_input.attributes);
+    return desc;
+}
+
+vulkan::compute_pipeline_desc_s cull_objects_pipeline_desc(const vk::PipelineLayout pipeline_layout) {
+    return {.compute_shader = "cull_objects.comp", .layout = pipeline_layout};
+}
+
+vulkan::compute_pipeline_desc_s cull_meshlets_pipeline_desc(const vk::PipelineLayout pipeline_layout) {
+    return {.compute_shader = "cull_meshlets.comp", .layout = pipeline_layout};
+}
+
+} // namespace sm::arcane::objects::shaders
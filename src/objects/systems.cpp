@@ -0,0 +1,450 @@
+#include "systems.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include "cameras/frustum_culling.hpp"
+#include "cameras/transform_kernel.hpp"
+
+namespace sm::arcane::objects {
+
+namespace {
+
+// `local_size_x` of `cull_objects.comp`
+constexpr auto g_cull_objects_group_size = std::uint32_t{64};
+
+// an object's bounds relative to the camera, like its model matrix, and the largest scale of that matrix, which any
+// length of the mesh grows by
+struct world_bounds_s {
+    glm::f32vec3 center;
+    float radius;
+    float scale;
+};
+
+[[nodiscard]] world_bounds_s to_world(const glm::f32mat4 &model_matrix,
+                                      const primitive_graphics::bounding_sphere_s &bounds) noexcept {
+    const auto scale = glm::max(glm::length(glm::f32vec3{model_matrix[0]}),
+                                glm::max(glm::length(glm::f32vec3{model_matrix[1]}),
+                                         glm::length(glm::f32vec3{model_matrix[2]})));
+    return {.center = glm::f32vec3{model_matrix * glm::f32vec4{bounds.center, 1.0f}},
+            .radius = bounds.radius * scale,
+            .scale = scale};
+}
+
+// the coarsest level whose error is invisible from the camera; the errors grow with the level
+[[nodiscard]] std::uint32_t select_lod(const cameras::lod_view_s &lod_view,
+                                       const primitive_graphics::Mesh &mesh,
+                                       const world_bounds_s &bounds) noexcept {
+    auto lod = std::uint32_t{0};
+    while (lod + 1 < mesh.lod_count() &&
+           lod_view.accepts_error(mesh.lod(lod + 1).error * bounds.scale, bounds.center, bounds.radius)) {
+        ++lod;
+    }
+    return lod;
+}
+
+} // namespace
+
+void DrawGameObjectSystem::sync(const scene::EntityRegistry &entities) {
+    const auto &components = entities.components();
+    if (m_synced_structure_version != entities.structure_version()) {
+        // the batches come in the order their meshes first appear in, the instances of a batch in the order of their
+        // entities
+        m_mesh_batches.clear();
+        auto mesh_batch_indices = std::unordered_map<const primitive_graphics::Mesh *, std::uint32_t>{};
+        auto entity_batches = std::vector<std::uint32_t>(entities.size());
+        for (auto index = std::size_t{0}; index < entities.size(); ++index) {
+            const auto &mesh = components.meshes[index];
+            if (!mesh) {
+                continue;
+            }
+            const auto [it, is_inserted] = mesh_batch_indices.try_emplace(
+                    mesh.get(),
+                    static_cast<std::uint32_t>(m_mesh_batches.size()));
+            if (is_inserted) {
+                m_mesh_batches.push_back(mesh_batch_s{.mesh = mesh});
+            }
+            ++m_mesh_batches[it->second].instance_count;
+            entity_batches[index] = it->second;
+        }
+
+        auto instance_count = std::uint32_t{0};
+        auto batch_ends = std::vector<std::uint32_t>(m_mesh_batches.size());
+        for (auto batch_index = std::size_t{0}; batch_index < m_mesh_batches.size(); ++batch_index) {
+            m_mesh_batches[batch_index].first_instance = instance_count;
+            batch_ends[batch_index] = instance_count;
+            instance_count += m_mesh_batches[batch_index].instance_count;
+        }
+        m_instance_entities.resize(instance_count);
+        for (auto index = std::uint32_t{0}; index < entities.size(); ++index) {
+            if (components.meshes[index]) {
+                m_instance_entities[batch_ends[entity_batches[index]]++] = index;
+            }
+        }
+        m_synced_structure_version = entities.structure_version();
+    }
+}
+
+void DrawGameObjectSystem::write_instances(const scene::EntityRegistry &entities,
+                                           const glm::f64vec3 &origin,
+                                           const mesh_batch_s &batch,
+                                           const std::span<object_instance_s> instances) const noexcept {
+    const auto &components = entities.components();
+    const auto batch_entities = std::span{m_instance_entities}.subspan(batch.first_instance, batch.instance_count);
+    assert(instances.size() == batch_entities.size());
+
+    // the model matrix also dequantizes the positions of compact meshes; the normal matrix is left as is, since the
+    // dequantization scale is uniform
+    const auto &vertex_transform = batch.mesh->vertex_transform();
+    auto *const first_instance = reinterpret_cast<std::byte *>(instances.data());
+    cameras::compute_matrices(
+            {.positions = components.world_positions,
+             .orientations = components.world_orientations,
+             .scales = components.world_scales,
+             .indices = batch_entities,
+             .origin = origin,
+             .vertex_transform = glm::f32vec4{glm::f32vec3{vertex_transform[3]}, vertex_transform[0][0]}},
+            {.model_matrices = first_instance + offsetof(object_instance_s, model_matrix),
+             .normal_matrices = first_instance + offsetof(object_instance_s, normal_matrix),
+             .stride = sizeof(object_instance_s)});
+    for (auto i = std::size_t{0}; i < instances.size(); ++i) {
+        instances[i].color = glm::f32vec4{components.colors[batch_entities[i]], 1.0f};
+    }
+}
+
+vulkan::GrowableBuffer &DrawGameObjectSystem::reserve_object_buffer(const std::uint32_t frame_index,
+                                                                    const vk::DeviceSize size) {
+    while (m_object_buffers.size() <= frame_index) {
+        m_object_buffers.emplace_back(m_device, m_bindless_heap, vk::BufferUsageFlagBits::eStorageBuffer);
+    }
+    auto &buffer = m_object_buffers[frame_index];
+    buffer.reserve(size);
+    return buffer;
+}
+
+void DrawGameObjectSystem::cull(const render::render_args_s &args) {
+    sync(args.entities);
+
+    const auto &mesh_batches = m_mesh_batches;
+    const auto object_count = m_instance_entities.size();
+    if (object_count == 0 || draws_with_push_constants()) {
+        return;
+    }
+
+    // all the transforms of the frame go to the GPU in one batch, at the start of the object buffer of the frame, so
+    // an instance index is also the `firstInstance` of its draw; the objects culled on the GPU follow them
+    const auto instances_size = sizeof(object_instance_s) * object_count;
+    const auto cull_objects_size = m_resources.cull_objects_pipeline ? sizeof(cull_object_s) * object_count : 0;
+    const auto &object_buffer = reserve_object_buffer(args.device.frame_index(), instances_size + cull_objects_size);
+    const auto instances = object_buffer.mapped_span<object_instance_s>().first(object_count);
+    m_frame_draws.instance_buffer_id = object_buffer.bindless_id();
+
+    if (!m_resources.cull_objects_pipeline) {
+        // the bounds of every object are laid out one array per component, so they are culled several at a time, split
+        // across the threads of the pool, into the compact list of the visible objects in the order of the batches
+        auto &bounds = m_object_bounds;
+        m_all_instances.resize(object_count);
+        bounds.centers_x.resize(object_count);
+        bounds.centers_y.resize(object_count);
+        bounds.centers_z.resize(object_count);
+        bounds.radii.resize(object_count);
+        bounds.scales.resize(object_count);
+        for (const auto &batch : mesh_batches) {
+            write_instances(args.entities,
+                            args.origin,
+                            batch,
+                            std::span{m_all_instances}.subspan(batch.first_instance, batch.instance_count));
+            for (auto object_index = batch.first_instance; object_index < batch.first_instance + batch.instance_count;
+                 ++object_index) {
+                const auto object_bounds = to_world(m_all_instances[object_index].model_matrix,
+                                                    batch.mesh->vertex_bounds());
+                bounds.centers_x[object_index] = object_bounds.center.x;
+                bounds.centers_y[object_index] = object_bounds.center.y;
+                bounds.centers_z[object_index] = object_bounds.center.z;
+                bounds.radii[object_index] = object_bounds.radius;
+                bounds.scales[object_index] = object_bounds.scale;
+            }
+        }
+        m_visible_objects.resize(object_count);
+        const auto visible_objects = std::span{m_visible_objects}.first(
+                cameras::cull_spheres(args.frustum,
+                                      {.centers_x = bounds.centers_x,
+                                       .centers_y = bounds.centers_y,
+                                       .centers_z = bounds.centers_z,
+                                       .radii = bounds.radii},
+                                      m_visible_objects,
+                                      args.thread_pool));
+
+        // only the visible objects are written, sorted by their level of detail within their batch, so each level of a
+        // batch stays contiguous and is drawn with a single draw
+        auto &lod_draws = m_frame_draws.lod_draws;
+        lod_draws.clear();
+        auto object_lods = std::vector<std::uint32_t>{};
+        auto lod_offsets = std::vector<std::uint32_t>{};
+        auto first_instance = std::uint32_t{0};
+        auto batch_visible_first = visible_objects.begin();
+        for (auto batch_index = std::uint32_t{0}; batch_index < mesh_batches.size(); ++batch_index) {
+            const auto &[mesh, batch_first_instance, batch_instance_count] = mesh_batches[batch_index];
+            const auto batch_visible_last = std::lower_bound(batch_visible_first,
+                                                             visible_objects.end(),
+                                                             batch_first_instance + batch_instance_count);
+            const auto batch_visible = std::span{batch_visible_first, batch_visible_last};
+            batch_visible_first = batch_visible_last;
+
+            object_lods.resize(batch_visible.size());
+            lod_offsets.assign(mesh->lod_count() + 1, 0);
+            for (auto i = std::size_t{0}; i < batch_visible.size(); ++i) {
+                const auto object_index = batch_visible[i];
+                const auto object_bounds = world_bounds_s{.center = {bounds.centers_x[object_index],
+                                                                     bounds.centers_y[object_index],
+                                                                     bounds.centers_z[object_index]},
+                                                          .radius = bounds.radii[object_index],
+                                                          .scale = bounds.scales[object_index]};
+                object_lods[i] = select_lod(args.lod_view, *mesh, object_bounds);
+                ++lod_offsets[object_lods[i] + 1];
+            }
+
+            for (auto lod = std::uint32_t{0}; lod < mesh->lod_count(); ++lod) {
+                if (const auto instance_count = lod_offsets[lod + 1]; instance_count > 0) {
+                    lod_draws.push_back({.batch_index = batch_index, .lod = lod, .instance_count = instance_count});
+                }
+                lod_offsets[lod + 1] += lod_offsets[lod];
+            }
+            for (auto i = std::size_t{0}; i < batch_visible.size(); ++i) {
+                instances[first_instance + lod_offsets[object_lods[i]]++] = m_all_instances[batch_visible[i]];
+            }
+            first_instance += static_cast<std::uint32_t>(batch_visible.size());
+        }
+        object_buffer.flush(0, sizeof(object_instance_s) * first_instance);
+        return;
+    }
+
+    // the batches of one geometry block and vertex format share a draw group; each object may emit a command, or one
+    // per meshlet of its level of detail, so a group has room for as many as its batches' objects may emit
+    auto &draw_groups = m_frame_draws.draw_groups;
+    draw_groups.clear();
+    const auto batch_allocation = args.frame_allocator.allocate(sizeof(cull_batch_s) * mesh_batches.size(),
+                                                                sizeof(cull_batch_s));
+    const auto cull_batches = batch_allocation.as<cull_batch_s>();
+    auto draws_meshlets = false;
+    for (auto batch_index = std::size_t{0}; batch_index < mesh_batches.size(); ++batch_index) {
+        const auto &mesh = mesh_batches[batch_index].mesh;
+        auto group = std::ranges::find_if(draw_groups, [&mesh](const draw_group_s &draw_group) {
+            return draw_group.geometry_block == mesh->geometry_block() &&
+                   draw_group.vertex_format == mesh->vertex_format();
+        });
+        if (group == draw_groups.end()) {
+            group = draw_groups.insert(group,
+                                       draw_group_s{.geometry_block = mesh->geometry_block(),
+                                                    .vertex_format = mesh->vertex_format()});
+        }
+
+        const auto &bounds = mesh->vertex_bounds();
+        // the levels of detail and the meshlets stay in the table of the mesh, uploaded once with it
+        cull_batches[batch_index] = {.bounding_sphere = glm::f32vec4{bounds.center, bounds.radius},
+                                     .base_vertex = mesh->base_vertex(),
+                                     .draw_group = static_cast<std::uint32_t>(group - draw_groups.begin()),
+                                     .first_index = mesh->first_index(),
+                                     .lod_count = static_cast<std::uint32_t>(mesh->lod_count()),
+                                     .table_id = mesh->table_id(),
+                                     .first_table_element = mesh->first_table_element(),
+                                     .tests_cones = (shaders::g_draw_object_cull_mode & vk::CullModeFlagBits::eBack)
+                                                            ? 1u
+                                                            : 0u,
+                                     .padding = {}};
+        auto max_object_draw_count = std::size_t{1};
+        for (auto lod = std::size_t{0}; lod < mesh->lod_count(); ++lod) {
+            const auto meshlets = mesh->meshlets(lod);
+            // `cull_objects.comp` only splits levels of more than one meshlet
+            if (meshlets.size() > 1) {
+                max_object_draw_count = std::max(max_object_draw_count, meshlets.size());
+                draws_meshlets = true;
+            }
+        }
+        group->max_draw_count += static_cast<std::uint32_t>(mesh_batches[batch_index].instance_count *
+                                                            max_object_draw_count);
+    }
+
+    const auto view_allocation = args.frame_allocator.allocate(sizeof(cull_view_s), sizeof(glm::f32vec4));
+    view_allocation.as<cull_view_s>()[0] = {.frustum_planes = args.frustum.planes,
+                                            .lod_view = glm::f32vec4{args.lod_view.position,
+                                                                     args.lod_view.lod_scale}};
+
+    // zeroed counts and the first commands of the groups; like every host write of the frame, they are visible to
+    // the frame's commands once submitted
+    const auto draw_group_allocation = args.frame_allocator.allocate(2 * sizeof(std::uint32_t) * draw_groups.size());
+    const auto draw_group_words = draw_group_allocation.as<std::uint32_t>();
+    auto first_command = std::uint32_t{0};
+    for (auto group_index = std::size_t{0}; group_index < draw_groups.size(); ++group_index) {
+        draw_groups[group_index].first_command = first_command;
+        draw_group_words[2 * group_index] = 0;
+        draw_group_words[2 * group_index + 1] = first_command;
+        first_command += draw_groups[group_index].max_draw_count;
+    }
+
+    const auto first_cull_object = instances_size / sizeof(cull_object_s);
+    const auto cull_objects = object_buffer.mapped_span<cull_object_s>().subspan(first_cull_object, object_count);
+    for (auto batch_index = std::uint32_t{0}; batch_index < mesh_batches.size(); ++batch_index) {
+        const auto &batch = mesh_batches[batch_index];
+        write_instances(args.entities,
+                        args.origin,
+                        batch,
+                        instances.subspan(batch.first_instance, batch.instance_count));
+        for (auto instance_index = batch.first_instance; instance_index < batch.first_instance + batch.instance_count;
+             ++instance_index) {
+            cull_objects[instance_index] = {.instance_index = instance_index, .batch_index = batch_index};
+        }
+    }
+    object_buffer.flush(0, instances_size + cull_objects_size);
+
+    // the commands, then the objects `cull_objects.comp` leaves to `cull_meshlets.comp`, are only written and read by
+    // the GPU; the dispatch that counts those objects stays with the draw groups
+    const auto commands_size = sizeof(vk::DrawIndexedIndirectCommand) * first_command;
+    const auto first_meshlet_object = (commands_size + sizeof(cull_meshlet_object_s) - 1) /
+                                      sizeof(cull_meshlet_object_s);
+    m_draw_buffer.reserve(sizeof(cull_meshlet_object_s) * (first_meshlet_object + (draws_meshlets ? object_count : 1)));
+    // the dispatch, then the number of meshlet objects
+    const auto dispatch_allocation = args.frame_allocator.push(std::array<std::uint32_t, 4>{0, 1, 1, 0});
+
+    m_frame_draws.draw_buffer = m_draw_buffer.buffer();
+    m_frame_draws.draw_group_buffer = draw_group_allocation.buffer;
+    m_frame_draws.draw_groups_offset = draw_group_allocation.offset;
+
+    const auto push_constants = cull_push_constants_s{
+            .buffer_id = m_resources.frame_buffer_id,
+            .object_buffer_id = object_buffer.bindless_id(),
+            .draw_buffer_id = m_draw_buffer.bindless_id(),
+            .first_cull_view_vector = static_cast<std::uint32_t>(view_allocation.offset / sizeof(glm::f32vec4)),
+            .first_cull_batch = static_cast<std::uint32_t>(batch_allocation.offset / sizeof(cull_batch_s)),
+            .first_cull_object = static_cast<std::uint32_t>(first_cull_object),
+            .cull_object_count = static_cast<std::uint32_t>(object_count),
+            .first_meshlet_object = static_cast<std::uint32_t>(first_meshlet_object),
+            .first_command_word = 0,
+            .first_draw_group_word = static_cast<std::uint32_t>(draw_group_allocation.offset /
+                                                                sizeof(std::uint32_t)),
+            .meshlet_dispatch_word = static_cast<std::uint32_t>(dispatch_allocation.offset / sizeof(std::uint32_t)),
+            .max_meshlet_group_count = m_resources.max_meshlet_group_count};
+
+    // the draw buffer is shared by the frames in flight: the previous frame is done drawing from it and culling into it
+    // before this one writes it again
+    const auto reuse_barrier = vk::MemoryBarrier2{
+            vk::PipelineStageFlagBits2::eComputeShader | vk::PipelineStageFlagBits2::eDrawIndirect,
+            vk::AccessFlagBits2::eShaderStorageWrite,
+            vk::PipelineStageFlagBits2::eComputeShader,
+            vk::AccessFlagBits2::eShaderStorageRead | vk::AccessFlagBits2::eShaderStorageWrite};
+    args.command_buffer.pipelineBarrier2KHR(vk::DependencyInfo{{}, reuse_barrier});
+
+    args.command_buffer.bindPipeline(vk::PipelineBindPoint::eCompute, **m_resources.cull_objects_pipeline);
+    args.command_buffer.pushConstants<cull_push_constants_s>(args.global.pipeline_layout,
+                                                             render::g_push_constants_stages,
+                                                             0,
+                                                             push_constants);
+    args.command_buffer.dispatch((push_constants.cull_object_count + g_cull_objects_group_size - 1) /
+                                         g_cull_objects_group_size,
+                                 1,
+                                 1);
+
+    if (draws_meshlets) {
+        // the meshlet objects and the group counts written above are read and added to, the dispatch is read as
+        // indirect arguments; the push constants stay, the layout is the same
+        const auto meshlet_barrier = vk::MemoryBarrier2{
+                vk::PipelineStageFlagBits2::eComputeShader,
+                vk::AccessFlagBits2::eShaderStorageWrite,
+                vk::PipelineStageFlagBits2::eComputeShader | vk::PipelineStageFlagBits2::eDrawIndirect,
+                vk::AccessFlagBits2::eShaderStorageRead | vk::AccessFlagBits2::eShaderStorageWrite |
+                        vk::AccessFlagBits2::eIndirectCommandRead};
+        args.command_buffer.pipelineBarrier2KHR(vk::DependencyInfo{{}, meshlet_barrier});
+
+        args.command_buffer.bindPipeline(vk::PipelineBindPoint::eCompute, **m_resources.cull_meshlets_pipeline);
+        args.command_buffer.dispatchIndirect(dispatch_allocation.buffer, dispatch_allocation.offset);
+    }
+
+    const auto barrier = vk::MemoryBarrier2{vk::PipelineStageFlagBits2::eComputeShader,
+                                            vk::AccessFlagBits2::eShaderStorageWrite,
+                                            vk::PipelineStageFlagBits2::eDrawIndirect,
+                                            vk::AccessFlagBits2::eIndirectCommandRead};
+    args.command_buffer.pipelineBarrier2KHR(vk::DependencyInfo{{}, barrier});
+}
+
+void DrawGameObjectSystem::render(const render::render_args_s &args) const {
+    const auto &mesh_batches = m_mesh_batches;
+    if (m_instance_entities.empty()) {
+        return;
+    }
+
+    if (draws_with_push_constants()) {
+        auto instance = object_instance_s{};
+        write_instances(args.entities, args.origin, mesh_batches.front(), std::span{&instance, 1});
+        const auto &mesh = mesh_batches.front().mesh;
+        const auto push_constants = primitive_graphics::Mesh::simple_push_consts_data_s{
+                .model_matrix = instance.model_matrix,
+                .normal_matrix = glm::f32mat4{glm::f32mat3{instance.normal_matrix}}};
+
+        args.command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, **m_resources.draw_object_pipeline);
+        args.command_buffer.pushConstants<primitive_graphics::Mesh::simple_push_consts_data_s>(
+                args.global.pipeline_layout,
+                render::g_push_constants_stages,
+                0,
+                push_constants);
+
+        mesh->bind(args.command_buffer);
+        mesh->draw(args.command_buffer);
+        return;
+    }
+
+    // push constants outlive pipeline binds within the same layout, so the id is pushed once for every pipeline below
+    args.command_buffer.pushConstants<vulkan::bindless_id_t>(args.global.pipeline_layout,
+                                                             render::g_push_constants_stages,
+                                                             0,
+                                                             m_frame_draws.instance_buffer_id);
+
+    if (m_resources.cull_objects_pipeline) {
+        // the commands carry the first index and the base vertex of their meshes, so a single draw covers every mesh
+        // of a group
+        for (auto group_index = std::size_t{0}; group_index < m_frame_draws.draw_groups.size(); ++group_index) {
+            const auto &group = m_frame_draws.draw_groups[group_index];
+            args.command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics,
+                                             **m_resources.instanced_pipeline(group.vertex_format));
+            args.geometry_pool.bind(args.command_buffer, group.geometry_block);
+            args.command_buffer.drawIndexedIndirectCount(
+                    m_frame_draws.draw_buffer,
+                    group.first_command * sizeof(vk::DrawIndexedIndirectCommand),
+                    m_frame_draws.draw_group_buffer,
+                    m_frame_draws.draw_groups_offset + 2 * sizeof(std::uint32_t) * group_index,
+                    group.max_draw_count,
+                    sizeof(vk::DrawIndexedIndirectCommand));
+        }
+        return;
+    }
+
+    // the visible instances of a batch at one level of detail are contiguous in the array, so one draw covers all of
+    // them
+    auto first_instance = std::uint32_t{0};
+    auto bound_geometry_block = std::optional<std::uint32_t>{};
+    auto bound_vertex_format = std::optional<primitive_graphics::vertex_format_e>{};
+    for (const auto &[batch_index, lod, instance_count] : m_frame_draws.lod_draws) {
+        const auto &mesh = mesh_batches[batch_index].mesh;
+        if (bound_vertex_format != mesh->vertex_format()) {
+            args.command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics,
+                                             **m_resources.instanced_pipeline(mesh->vertex_format()));
+            bound_vertex_format = mesh->vertex_format();
+        }
+        if (bound_geometry_block != mesh->geometry_block()) {
+            mesh->bind(args.command_buffer);
+            bound_geometry_block = mesh->geometry_block();
+        }
+        mesh->draw(args.command_buffer, instance_count, first_instance, lod);
+        first_instance += instance_count;
+    }
+}
+
+} // namespace sm::arcane::objects
@@ -3,56 +3,267 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <memory>
-#include <utility>
+#include <span>
+#include <vector>
 
+#include <glm/vec4.hpp>
+
+#include "cameras/frustum.hpp"
 #include "objects/game_object.hpp"
 #include "objects/shaders/draw_object_pipeline.hpp"
 #include "primitive_graphics/mesh.hpp"
 #include "render/common.hpp"
+#include "scene/entity_registry.hpp"
+#include "vulkan/bindless_heap.hpp"
+#include "vulkan/device.hpp"
+#include "vulkan/growable_buffer.hpp"
 
 namespace sm::arcane::objects {
 
+// The input of `cull_objects.comp` and `cull_meshlets.comp` (std430), once per frame: what the objects and meshlets
+// are culled against and the levels of detail selected with
+struct cull_view_s {
+    std::array<glm::f32vec4, cameras::frustum_s::count> frustum_planes;
+    // `xyz` is the camera position, i.e. the origin, `w` the `lod_scale` (see `cameras::lod_view_s`)
+    glm::f32vec4 lod_view;
+};
+static_assert(sizeof(cull_view_s) == 7 * sizeof(glm::f32vec4));
+
+// The input of `cull_objects.comp` (std430), one per mesh batch: what the draw of any of its objects is made of. The
+// levels of detail and the meshlets of the mesh are read from its table in the geometry pool, uploaded once with the
+// mesh (see `primitive_graphics::mesh_table_lod_s`); a level of more than one meshlet is drawn meshlet by meshlet,
+// each culled on its own by `cull_meshlets.comp`
+struct cull_batch_s {
+    // the bounding sphere of the mesh's stored vertices (`Mesh::vertex_bounds`): `xyz` is the center, `w` the radius
+    glm::f32vec4 bounding_sphere;
+    std::uint32_t base_vertex;
+    // the objects of all the batches in one block of the geometry pool are drawn by one indirect draw: its group
+    std::uint32_t draw_group;
+    // what the indices of the table are relative to
+    std::uint32_t first_index;
+    std::uint32_t lod_count;
+    vulkan::bindless_id_t table_id;
+    std::uint32_t first_table_element;
+    // whether the meshlets are culled by their normal cones, only when the mesh's pipeline culls back faces (see
+    // `shaders::g_draw_object_cull_mode`): a culled cone would drop triangles a double-sided draw shows
+    std::uint32_t tests_cones;
+    std::array<std::uint32_t, 5> padding;
+};
+// a power of two, which the frame allocator aligns to
+static_assert(sizeof(cull_batch_s) == 64);
+
+// The input of `cull_objects.comp` (std430), one per object, after the instances in the object buffer of the frame
+struct cull_object_s {
+    // into the instance array, also the `firstInstance` of the object's draw
+    std::uint32_t instance_index;
+    std::uint32_t batch_index;
+};
+static_assert(sizeof(cull_object_s) == 8);
+
+// The output of `cull_objects.comp` and the input of `cull_meshlets.comp` (std430), one per visible object drawn
+// meshlet by meshlet: each is culled by one workgroup of the indirect dispatch
+struct cull_meshlet_object_s {
+    std::uint32_t instance_index;
+    std::uint32_t batch_index;
+    // relative to the table of the batch's mesh
+    std::uint32_t first_meshlet;
+    std::uint32_t meshlet_count;
+};
+static_assert(sizeof(cull_meshlet_object_s) == 16);
+
+// The push constants of `cull_objects.comp` and `cull_meshlets.comp`, pushed once for both. The arrays they read or
+// write are found through bindless ids: the instances and the `cull_object_s` are in the object buffer of the frame,
+// the draw commands and the `cull_meshlet_object_s` in the draw buffer, the tables of the meshes in their blocks of
+// the geometry pool, every other array in the frame allocator buffer. They are addressed by element (the input), by
+// vector (the view, whose size isn't a power of two) or by 32-bit word (the draw commands, the draw groups, two words
+// each: the draw count, then the first command of the group, and the `VkDispatchIndirectCommand` of
+// `cull_meshlets.comp` followed by the number of meshlet objects. The group count of the dispatch is that number up to
+// `max_meshlet_group_count`, the device's limit: a workgroup culls every `max_meshlet_group_count`-th object then)
+struct cull_push_constants_s {
+    vulkan::bindless_id_t buffer_id;
+    vulkan::bindless_id_t object_buffer_id;
+    vulkan::bindless_id_t draw_buffer_id;
+    std::uint32_t first_cull_view_vector;
+    std::uint32_t first_cull_batch;
+    std::uint32_t first_cull_object;
+    std::uint32_t cull_object_count;
+    std::uint32_t first_meshlet_object;
+    std::uint32_t first_command_word;
+    std::uint32_t first_draw_group_word;
+    std::uint32_t meshlet_dispatch_word;
+    std::uint32_t max_meshlet_group_count;
+};
+static_assert(sizeof(cull_push_constants_s) <= render::g_push_constants_size);
+
 class DrawGameObjectSystem {
 public:
-    struct resources_s {
-        shaders::DynamicDrawObjectPipeline draw_object_pipeline;
+    // the entities sharing one mesh, drawn with a single instanced draw; their instances are contiguous
+    struct mesh_batch_s {
+        std::shared_ptr<primitive_graphics::Mesh> mesh;
+        std::uint32_t first_instance = 0;
+        std::uint32_t instance_count = 0;
+    };
 
-        GameObject game_object;
+    struct resources_s {
+        vulkan::pipeline_t draw_object_pipeline;
+        vulkan::pipeline_t draw_object_instanced_pipeline;
+        vulkan::pipeline_t draw_object_instanced_compact_pipeline;
+        // empty when the device can't draw with `vkCmdDrawIndexedIndirectCount`: objects are culled on the CPU then,
+        // as a whole
+        vulkan::pipeline_t cull_objects_pipeline;
+        vulkan::pipeline_t cull_meshlets_pipeline;
+        // the frame allocator buffer: the culling input of the meshes and the indirect draws of a frame are there
+        vulkan::bindless_id_t frame_buffer_id;
+        // `maxComputeWorkGroupCount[0]`, which the meshlet objects may outnumber
+        std::uint32_t max_meshlet_group_count;
 
         [[nodiscard]] static resources_s create(const render::pass_context_s &ctx) {
-            auto vertices = primitive_graphics::blanks::cube_normal_vertices;
-            auto indices = primitive_graphics::blanks::cube_indices;
-
-            auto mesh = std::make_shared<primitive_graphics::Mesh>(ctx.device,
-                                                                   *ctx.swapchain->command_pool(),
-                                                                   std::move(vertices),
-                                                                   std::move(indices));
-
-            return {.draw_object_pipeline = {ctx.device.device(),
-                                             ctx.global.descriptor_set_layout,
-                                             ctx.swapchain->color_format(),
-                                             ctx.swapchain->depth_format()},
-                    .game_object = GameObject{std::move(mesh)}};
+            return {
+                    .draw_object_pipeline = ctx.pipeline_registry.register_pipeline(
+                            shaders::draw_object_pipeline_desc(ctx.global.pipeline_layout,
+                                                               ctx.swapchain->color_format(),
+                                                               ctx.swapchain->depth_format())),
+                    .draw_object_instanced_pipeline = ctx.pipeline_registry.register_pipeline(
+                            shaders::draw_object_instanced_pipeline_desc(ctx.global.pipeline_layout,
+                                                                         ctx.swapchain->color_format(),
+                                                                         ctx.swapchain->depth_format(),
+                                                                         primitive_graphics::vertex_format_e::full)),
+                    .draw_object_instanced_compact_pipeline = ctx.pipeline_registry.register_pipeline(
+                            shaders::draw_object_instanced_pipeline_desc(ctx.global.pipeline_layout,
+                                                                         ctx.swapchain->color_format(),
+                                                                         ctx.swapchain->depth_format(),
+                                                                         primitive_graphics::vertex_format_e::compact)),
+                    .cull_objects_pipeline = ctx.device.supports_draw_indirect_count()
+                                                     ? ctx.pipeline_registry.register_pipeline(
+                                                               shaders::cull_objects_pipeline_desc(
+                                                                       ctx.global.pipeline_layout))
+                                                     : nullptr,
+                    .cull_meshlets_pipeline = ctx.device.supports_draw_indirect_count()
+                                                      ? ctx.pipeline_registry.register_pipeline(
+                                                                shaders::cull_meshlets_pipeline_desc(
+                                                                        ctx.global.pipeline_layout))
+                                                      : nullptr,
+                    .frame_buffer_id = ctx.global.frame_allocator_buffer_id,
+                    .max_meshlet_group_count =
+                            ctx.device.physical_device().getProperties().limits.maxComputeWorkGroupCount[0]};
+        }
+
+        [[nodiscard]] const vulkan::pipeline_t &instanced_pipeline(
+                const primitive_graphics::vertex_format_e vertex_format) const noexcept {
+            return vertex_format == primitive_graphics::vertex_format_e::full ? draw_object_instanced_pipeline
+                                                                              : draw_object_instanced_compact_pipeline;
         }
     };
 
-    explicit DrawGameObjectSystem(const render::pass_context_s &ctx) : m_resources{resources_s::create(ctx)} {}
+    explicit DrawGameObjectSystem(const render::pass_context_s &ctx)
+        : m_resources{resources_s::create(ctx)},
+          m_device{ctx.device},
+          m_bindless_heap{ctx.bindless_heap},
+          m_draw_buffer{ctx.device,
+                        ctx.bindless_heap,
+                        vk::BufferUsageFlagBits::eIndirectBuffer,
+                        vk::MemoryPropertyFlagBits::eDeviceLocal} {}
 
-    void render(const render::render_args_s &args) const {
-        args.command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, *m_resources.draw_object_pipeline.handle());
+    // Must be recorded outside of the rendering scope, with the global sets bound to the compute bind point. The
+    // entities of `args.entities` having a mesh are drawn. Writes the instances of the frame, culls them against
+    // `args.frustum` and selects the level of detail of each from `args.lod_view`: on the GPU when
+    // `cull_objects_pipeline` is there, which leaves the draw commands and their per-batch counts to `render`, on the
+    // CPU otherwise. On the GPU, the meshlets of the visible objects are then culled against the frustum and, when
+    // back faces are culled, by their normal cones, one draw command per visible meshlet
+    void cull(const render::render_args_s &args);
 
-        args.command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-                                               *m_resources.draw_object_pipeline.layout(),
-                                               0,
-                                               {args.global.descriptor_set},
-                                               nullptr);
+    // A single object is drawn with its transforms in push constants, at its finest level of detail. Otherwise the
+    // instances written by `cull` are drawn with one indirect count draw per block of the geometry pool and vertex
+    // format, or one instanced draw per batch and level of detail
+    void render(const render::render_args_s &args) const;
 
-        m_resources.game_object.mesh()->bind(args.command_buffer);
-        m_resources.game_object.mesh()->draw(args.command_buffer);
+    resources_s m_resources;
+
+private:
+    // regroups the entities by mesh when the structure of the registry has changed since the last frame
+    void sync(const scene::EntityRegistry &entities);
+
+    // the object buffer of the frame in flight `frame_index`, with room for `size` bytes
+    [[nodiscard]] vulkan::GrowableBuffer &reserve_object_buffer(std::uint32_t frame_index, vk::DeviceSize size);
+
+    // computes the instances of the entities of `batch` straight into `instances`, in the order of the batch, with
+    // the model matrices relative to `origin`
+    void write_instances(const scene::EntityRegistry &entities,
+                         const glm::f64vec3 &origin,
+                         const mesh_batch_s &batch,
+                         std::span<object_instance_s> instances) const noexcept;
+
+    // `draw_object.vert` only reads full vertices
+    [[nodiscard]] bool draws_with_push_constants() const noexcept {
+        return m_instance_entities.size() == 1 &&
+               m_mesh_batches.front().mesh->vertex_format() == primitive_graphics::vertex_format_e::full;
     }
 
-    resources_s m_resources;
+    // the meshes of a group share both their buffers and their pipeline
+    struct draw_group_s {
+        std::uint32_t geometry_block = 0;
+        primitive_graphics::vertex_format_e vertex_format = primitive_graphics::vertex_format_e::full;
+        // relative to the frame's commands
+        std::uint32_t first_command = 0;
+        std::uint32_t max_draw_count = 0;
+    };
+
+    // the visible objects of a batch drawn at one level of detail, when culled on the CPU
+    struct lod_draw_s {
+        std::uint32_t batch_index = 0;
+        std::uint32_t lod = 0;
+        std::uint32_t instance_count = 0;
+    };
+
+    // what `cull` has prepared for `render` in the current frame
+    struct frame_draws_s {
+        vulkan::bindless_id_t instance_buffer_id = vulkan::g_invalid_bindless_id;
+
+        // the commands, from its start
+        vk::Buffer draw_buffer = nullptr;
+        vk::Buffer draw_group_buffer = nullptr;
+        vk::DeviceSize draw_groups_offset = 0;
+        std::vector<draw_group_s> draw_groups;
+
+        // in the order of their instances, only when culled on the CPU
+        std::vector<lod_draw_s> lod_draws;
+    };
+
+    // the entities are kept grouped by their mesh, so drawing never has to sort or look anything up
+    std::vector<mesh_batch_s> m_mesh_batches;
+    // the dense index of the entity of every instance, in the order of the batches
+    std::vector<std::uint32_t> m_instance_entities;
+    std::uint64_t m_synced_structure_version = std::numeric_limits<std::uint64_t>::max();
+
+    vulkan::Device &m_device;
+    vulkan::BindlessHeap &m_bindless_heap;
+    // The instances of a frame and, when culled on the GPU, the `cull_object_s` after them: one element per object,
+    // so these arrays grow with the registry instead of taking from the frame allocator. One buffer per frame in
+    // flight, as the host writes those of a frame while the GPU may still read those of the previous ones
+    std::vector<vulkan::GrowableBuffer> m_object_buffers;
+    // The draw commands and the meshlet objects of the frame when culled on the GPU, with room for as many as every
+    // object may emit: device-local, as only the GPU writes and reads them, and grown with the objects and their
+    // meshlets rather than taking the worst case from the frame allocator
+    vulkan::GrowableBuffer m_draw_buffer;
+
+    frame_draws_s m_frame_draws;
+    // when culled on the CPU: the instances of every entity, culled or not, their bounds relative to the camera (see
+    // `world_bounds_s`), and the indices of the visible ones
+    struct object_bounds_s {
+        std::vector<float> centers_x;
+        std::vector<float> centers_y;
+        std::vector<float> centers_z;
+        std::vector<float> radii;
+        std::vector<float> scales;
+    };
+    std::vector<object_instance_s> m_all_instances;
+    object_bounds_s m_object_bounds;
+    std::vector<std::uint32_t> m_visible_objects;
 };
 
 } // namespace sm::arcane::objects
\ No newline at end of file
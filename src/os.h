@@ -109,4 +109,28 @@
     #define SM_ARCANE_DISABLE_WARNING(warning_name)
 #endif
 
+
+// ================================================================
+// TARGET REGIONS
+// ================================================================
+
+// The functions defined between `SM_ARCANE_BEGIN_AVX2_TARGET` and `SM_ARCANE_END_AVX2_TARGET` are compiled for AVX2
+// and FMA, the rest of the translation unit for the baseline instruction set. Unlike compiling the whole translation
+// unit for AVX2, this keeps the inline functions it shares with others, e.g. of the standard library or glm, free of
+// AVX2 instructions, so the linker can't pick such a copy for callers running on any CPU. Include what the region
+// depends on before it begins, only the templates written for it within it (e.g. `cameras/transform_lanes.hpp`); what
+// is defined in the region must only run once `util::simd_level` has reported AVX2. MSVC emits the intrinsics of any
+// instruction set as they are, so it needs no region
+#if SM_ARCANE_COMPILER_CLANG
+    #define SM_ARCANE_BEGIN_AVX2_TARGET \
+        _Pragma("clang attribute push(__attribute__((target(\"avx2,fma\"))), apply_to = function)")
+    #define SM_ARCANE_END_AVX2_TARGET _Pragma("clang attribute pop")
+#elif SM_ARCANE_COMPILER_GCC
+    #define SM_ARCANE_BEGIN_AVX2_TARGET _Pragma("GCC push_options") _Pragma("GCC target(\"avx2,fma\")")
+    #define SM_ARCANE_END_AVX2_TARGET _Pragma("GCC pop_options")
+#else
+    #define SM_ARCANE_BEGIN_AVX2_TARGET
+    #define SM_ARCANE_END_AVX2_TARGET
+#endif
+
 #endif // SM_ARCANE_OS_H
\ No newline at end of file
@@ -1,79 +1,152 @@
 #include "mesh.hpp"
 
+#include <cassert>
+#include <cstddef>
+
+#include "primitive_graphics/mesh_cache.hpp"
+
 namespace sm::arcane::primitive_graphics {
 
 namespace {
 
-template<typename T>
-[[nodiscard]] vulkan::DeviceMemoryBuffer fill_buffer_impl(const vulkan::Device &device,
-                                                          const vk::CommandPool &command_pool,
-                                                          const std::vector<T> &data,
-                                                          const vk::BufferUsageFlags usages) {
-    const vk::DeviceSize buffer_size = sizeof(T) * data.size();
-    auto buffer = device.create_device_memory_buffer(usages | vk::BufferUsageFlagBits::eTransferDst,
-                                                     buffer_size,
-                                                     0,
-                                                     vk::MemoryPropertyFlagBits::eDeviceLocal);
-
-    buffer.upload(device.physical_device(),
-                  device.device(),
-                  device.queue_families().graphics.queue,
-                  command_pool,
-                  data,
-                  sizeof(T));
-
-    return buffer;
+// the levels, then the meshlets after them, see `mesh_table_lod_s`
+[[nodiscard]] std::vector<std::byte> build_table(const std::span<const mesh_lod_s> lods,
+                                                 const std::span<const meshlet_s> meshlets) {
+    auto table_lods = std::vector<mesh_table_lod_s>{};
+    table_lods.reserve(lods.size());
+    for (const auto &lod : lods) {
+        table_lods.push_back({.first_index = lod.first_index,
+                              .index_count = lod.index_count,
+                              .error = lod.error,
+                              .first_meshlet = static_cast<std::uint32_t>(lods.size()) + lod.first_meshlet,
+                              .meshlet_count = lod.meshlet_count});
+    }
+
+    auto table = std::vector<std::byte>{};
+    table.reserve(sizeof(mesh_table_lod_s) * lods.size() + sizeof(meshlet_s) * meshlets.size());
+    const auto lod_bytes = std::as_bytes(std::span{table_lods});
+    const auto meshlet_bytes = std::as_bytes(meshlets);
+    table.insert(table.end(), lod_bytes.begin(), lod_bytes.end());
+    table.insert(table.end(), meshlet_bytes.begin(), meshlet_bytes.end());
+    return table;
 }
 
-[[nodiscard]] vulkan::DeviceMemoryBuffer fill_vertex_buffer(const vulkan::Device &device,
-                                                            const vk::CommandPool &command_pool,
-                                                            const std::vector<Mesh::vertex_s> &vertices) {
+[[nodiscard]] vulkan::geometry_allocation_s allocate_geometry(vulkan::GeometryPool &geometry_pool,
+                                                              const std::span<const Mesh::vertex_s> vertices,
+                                                              const std::span<const std::uint32_t> indices,
+                                                              const vertex_format_e vertex_format,
+                                                              const glm::f32mat4 &vertex_transform,
+                                                              const std::span<const std::byte> table) {
     assert(vertices.size() >= 3 && "Mesh::vertex_s count must be at least 3");
-    return fill_buffer_impl(device, command_pool, vertices, vk::BufferUsageFlagBits::eVertexBuffer);
+    if (vertex_format == vertex_format_e::full) {
+        return geometry_pool.allocate(std::as_bytes(vertices), sizeof(Mesh::vertex_s), indices, table);
+    }
+
+    const auto compact_vertices = to_compact_vertices(vertices, vertex_transform);
+    return geometry_pool.allocate(std::as_bytes(std::span{compact_vertices}),
+                                  sizeof(Mesh::compact_vertex_s),
+                                  indices,
+                                  table);
+}
+
+// a mesh without levels of detail has a single one of every index
+[[nodiscard]] std::vector<mesh_lod_s> to_vertex_space(const std::span<const mesh_lod_s> lods,
+                                                      const std::size_t index_count,
+                                                      const glm::f32mat4 &vertex_transform) {
+    if (lods.empty()) {
+        return {mesh_lod_s{.first_index = 0, .index_count = static_cast<std::uint32_t>(index_count)}};
+    }
+
+    auto vertex_space_lods = std::vector<mesh_lod_s>{lods.begin(), lods.end()};
+    for (auto &lod : vertex_space_lods) {
+        assert(std::uint64_t{lod.first_index} + lod.index_count <= index_count);
+        lod.error /= vertex_transform[0][0];
+    }
+    return vertex_space_lods;
 }
 
-[[nodiscard]] vulkan::DeviceMemoryBuffer fill_index_buffer(const vulkan::Device &device,
-                                                           const vk::CommandPool &command_pool,
-                                                           const std::vector<std::uint32_t> &indices) {
-    if (indices.empty()) {
-        return nullptr;
+[[nodiscard]] std::vector<meshlet_s> to_vertex_space(const std::span<const meshlet_s> meshlets,
+                                                     const glm::f32mat4 &vertex_transform) {
+    auto vertex_space_meshlets = std::vector<meshlet_s>{meshlets.begin(), meshlets.end()};
+    for (auto &meshlet : vertex_space_meshlets) {
+        // the cone needs nothing: the vertex transform only scales uniformly and translates
+        const auto bounds = to_vertex_space(bounding_sphere_s{.center = meshlet.center, .radius = meshlet.radius},
+                                            vertex_transform);
+        meshlet.center = bounds.center;
+        meshlet.radius = bounds.radius;
     }
-    return fill_buffer_impl(device, command_pool, indices, vk::BufferUsageFlagBits::eIndexBuffer);
+    return vertex_space_meshlets;
 }
 
 } // namespace
 
-Mesh::Mesh(const vulkan::Device &device,
-           const vk::CommandPool &command_pool,
-           std::vector<vertex_s> &&vertices,
-           std::vector<std::uint32_t> &&indices)
-    : m_device{*device.device()},
-      m_vertices{std::move(vertices)},
-      m_vertex_count{static_cast<std::uint32_t>(m_vertices.size())},
-      m_vertex_buffer{fill_vertex_buffer(device, command_pool, m_vertices)},
-      m_indices{std::move(indices)},
-      m_exists_index_buffer{!m_indices.empty()},
-      m_index_count{static_cast<std::uint32_t>(m_indices.size())},
-      m_index_buffer{m_indices.empty() ? nullptr : fill_index_buffer(device, command_pool, m_indices)} {}
+Mesh::Mesh(vulkan::GeometryPool &geometry_pool,
+           const std::span<const vertex_s> vertices,
+           const std::span<const std::uint32_t> indices,
+           const vertex_format_e vertex_format)
+    : m_geometry_pool{geometry_pool},
+      m_vertex_format{vertex_format},
+      m_bounds{compute_bounds(vertices)},
+      m_vertex_transform{compute_vertex_transform(compute_aabb(vertices), vertex_format)},
+      m_vertex_bounds{to_vertex_space(m_bounds, m_vertex_transform)},
+      m_lods{to_vertex_space({}, indices.size(), m_vertex_transform)},
+      m_geometry{allocate_geometry(geometry_pool,
+                                   vertices,
+                                   indices,
+                                   vertex_format,
+                                   m_vertex_transform,
+                                   build_table(m_lods, m_meshlets))},
+      m_vertex_count{static_cast<std::uint32_t>(vertices.size())} {}
 
+Mesh::Mesh(vulkan::GeometryPool &geometry_pool, const mesh_data_s &mesh_data, const vertex_format_e vertex_format)
+    : m_geometry_pool{geometry_pool},
+      m_vertex_format{vertex_format},
+      m_bounds{compute_bounds(mesh_data.vertices)},
+      m_vertex_transform{compute_vertex_transform(compute_aabb(mesh_data.vertices), vertex_format)},
+      m_vertex_bounds{to_vertex_space(m_bounds, m_vertex_transform)},
+      m_lods{to_vertex_space(mesh_data.lods, mesh_data.indices.size(), m_vertex_transform)},
+      m_meshlets{to_vertex_space(mesh_data.meshlets, m_vertex_transform)},
+      m_geometry{allocate_geometry(geometry_pool,
+                                   mesh_data.vertices,
+                                   mesh_data.indices,
+                                   vertex_format,
+                                   m_vertex_transform,
+                                   build_table(m_lods, m_meshlets))},
+      m_vertex_count{static_cast<std::uint32_t>(mesh_data.vertices.size())} {}
 
-void Mesh::bind(const vk::CommandBuffer command_buffer) const noexcept {
-    const auto vertex_buffers = std::vector{*m_vertex_buffer.buffer};
-    const auto offsets = std::vector<vk::DeviceSize>{0};
+Mesh::Mesh(vulkan::GeometryPool &geometry_pool, const MeshCache &mesh_cache)
+    : m_geometry_pool{geometry_pool},
+      m_vertex_format{mesh_cache.header().vertex_format},
+      m_bounds{mesh_cache.header().bounds},
+      m_vertex_transform{compute_vertex_transform(mesh_cache.header().aabb, m_vertex_format)},
+      m_vertex_bounds{to_vertex_space(m_bounds, m_vertex_transform)},
+      m_lods{to_vertex_space(mesh_cache.lods(), mesh_cache.header().index_count, m_vertex_transform)},
+      m_meshlets{to_vertex_space(mesh_cache.meshlets(), m_vertex_transform)},
+      m_geometry{geometry_pool.allocate(mesh_cache.vertices(),
+                                        mesh_cache.header().vertex_stride,
+                                        mesh_cache.indices(),
+                                        build_table(m_lods, m_meshlets))},
+      m_vertex_count{mesh_cache.header().vertex_count} {}
 
-    command_buffer.bindVertexBuffers(0, 1, vertex_buffers.data(), offsets.data());
+Mesh::~Mesh() { m_geometry_pool.release(m_geometry); }
 
-    if (m_exists_index_buffer) {
-        command_buffer.bindIndexBuffer(*m_index_buffer.buffer, 0, vk::IndexType::eUint32);
-    }
+void Mesh::bind(const vk::CommandBuffer command_buffer) const noexcept {
+    m_geometry_pool.bind(command_buffer, m_geometry.block);
 }
 
-void Mesh::draw(const vk::CommandBuffer command_buffer) const noexcept {
-    if (m_exists_index_buffer) {
-        command_buffer.drawIndexed(m_index_count, 1, 0, 0, 0);
+void Mesh::draw(const vk::CommandBuffer command_buffer,
+                const std::uint32_t instance_count,
+                const std::uint32_t first_instance,
+                const std::size_t lod) const noexcept {
+    if (index_count(lod) > 0) {
+        command_buffer.drawIndexed(index_count(lod),
+                                   instance_count,
+                                   first_index(lod),
+                                   static_cast<std::int32_t>(base_vertex()),
+                                   first_instance);
     } else {
-        command_buffer.draw(m_vertex_count, 1, 0, 0);
+        command_buffer.draw(m_vertex_count, instance_count, base_vertex(), first_instance);
     }
 }
 
-} // namespace sm::arcane::primitive_graphics
\ No newline at end of file
+} // namespace sm::arcane::primitive_graphics
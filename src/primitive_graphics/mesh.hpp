@@ -3,19 +3,42 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 #include <glm/fwd.hpp>
 #include <glm/mat4x4.hpp>
-#include <glm/vec3.hpp>
-#include <glm/vec4.hpp>
 
-#include "vulkan/device.hpp"
-#include "vulkan/device_memory.hpp"
+#include <vulkan/vulkan_raii.hpp>
+
+#include "primitive_graphics/mesh_data.hpp"
+#include "primitive_graphics/vertex_format.hpp"
+#include "vulkan/geometry_pool.hpp"
 
 namespace sm::arcane::primitive_graphics {
 
+class MeshCache;
+
+// A level of detail in the table a `Mesh` keeps in its block of the geometry pool (std430). The table is the levels of
+// the mesh, the finest first, then the meshlets of every level, with the indices relative to the mesh's own and the
+// meshlets relative to the table; the layout is the one `cull_objects.comp` reads
+struct mesh_table_lod_s {
+    std::uint32_t first_index = 0;
+    std::uint32_t index_count = 0;
+    // in the space of the stored positions, like `Mesh::vertex_bounds`
+    float error = 0.0f;
+    std::uint32_t first_meshlet = 0;
+    std::uint32_t meshlet_count = 0;
+    std::array<std::uint32_t, 3> padding{};
+};
+static_assert(sizeof(mesh_table_lod_s) == vulkan::g_geometry_table_element_size);
+static_assert(sizeof(meshlet_s) == vulkan::g_geometry_table_element_size);
+
+// A handle to geometry in a `vulkan::GeometryPool`: the mesh owns its vertex, index and table ranges, not buffers, and
+// gives them back to the pool when destroyed. Meshes in the same block of the pool are drawn after a single bind
 class Mesh {
 public:
     struct simple_push_consts_data_s {
@@ -23,45 +46,86 @@ public:
         glm::f32mat4 normal_matrix = glm::f32mat4{1.0f};
     };
 
-    struct vertex_s {
-        glm::f32vec3 position;
-        glm::f32vec4 color;
-        glm::f32vec3 normal;
-
-        [[nodiscard]] bool operator==(const vertex_s &other) const noexcept = default;
-    };
-
-    explicit Mesh(const vulkan::Device &device,
-                  const vk::CommandPool &command_pool,
-                  std::vector<vertex_s> &&vertices,
-                  std::vector<std::uint32_t> &&indices);
+    using vertex_s = primitive_graphics::vertex_s;
+    using compact_vertex_s = primitive_graphics::compact_vertex_s;
+
+    // the vertices are converted to `vertex_format` before being copied into the pool
+    explicit Mesh(vulkan::GeometryPool &geometry_pool,
+                  std::span<const vertex_s> vertices,
+                  std::span<const std::uint32_t> indices,
+                  vertex_format_e vertex_format = vertex_format_e::full);
+    // keeps the levels of detail of `mesh_data`, all of them in the one index range of the mesh
+    explicit Mesh(vulkan::GeometryPool &geometry_pool,
+                  const mesh_data_s &mesh_data,
+                  vertex_format_e vertex_format = vertex_format_e::full);
+    // the vertices and indices are copied into the pool straight from the mapped file, as they are stored
+    explicit Mesh(vulkan::GeometryPool &geometry_pool, const MeshCache &mesh_cache);
 
     Mesh(const Mesh &) = delete;
     Mesh &operator=(const Mesh &) = delete;
     Mesh(Mesh &&) noexcept = delete;
     Mesh &operator=(Mesh &&) noexcept = delete;
 
-    ~Mesh() = default;
+    ~Mesh();
 
+    // binds the buffers of the mesh's block; nothing has to be bound again for the other meshes of the same block
     void bind(vk::CommandBuffer command_buffer) const noexcept;
-    void draw(vk::CommandBuffer command_buffer) const noexcept;
-
-    [[nodiscard]] std::uint32_t vertex_count() const noexcept;
-    [[nodiscard]] const vulkan::DeviceMemoryBuffer &vertex_buffer() const noexcept;
-    [[nodiscard]] std::uint32_t index_count() const noexcept;
-    [[nodiscard]] const vulkan::DeviceMemoryBuffer &index_buffer() const noexcept;
+    void draw(vk::CommandBuffer command_buffer,
+              std::uint32_t instance_count = 1,
+              std::uint32_t first_instance = 0,
+              std::size_t lod = 0) const noexcept;
+
+    [[nodiscard]] vertex_format_e vertex_format() const noexcept { return m_vertex_format; }
+    // maps the vertex positions as stored in the pool to the local space of the mesh (see `compute_vertex_transform`),
+    // so it goes into the model matrix of whatever draws the mesh
+    [[nodiscard]] const glm::f32mat4 &vertex_transform() const noexcept { return m_vertex_transform; }
+
+    [[nodiscard]] const bounding_sphere_s &bounds() const noexcept { return m_bounds; }
+    // `bounds()` in the space of the stored positions, i.e. before `vertex_transform()`
+    [[nodiscard]] const bounding_sphere_s &vertex_bounds() const noexcept { return m_vertex_bounds; }
+    [[nodiscard]] std::uint32_t geometry_block() const noexcept { return m_geometry.block; }
+    [[nodiscard]] std::uint32_t base_vertex() const noexcept { return m_geometry.base_vertex(); }
+    [[nodiscard]] std::uint32_t vertex_count() const noexcept { return m_vertex_count; }
+    [[nodiscard]] std::uint32_t first_index(const std::size_t lod = 0) const noexcept {
+        return m_geometry.first_index() + m_lods[lod].first_index;
+    }
+    [[nodiscard]] std::uint32_t index_count(const std::size_t lod = 0) const noexcept {
+        return m_lods[lod].index_count;
+    }
+
+    // at least one, the finest first
+    [[nodiscard]] std::size_t lod_count() const noexcept { return m_lods.size(); }
+    // relative to the mesh's own indices, with the error in the space of the stored positions, like `vertex_bounds()`
+    [[nodiscard]] const mesh_lod_s &lod(const std::size_t lod) const noexcept { return m_lods[lod]; }
+
+    // the meshlets of a level, empty when none were built; their bounds are in the space of the stored positions and
+    // their indices relative to the mesh's own, see `first_index(const meshlet_s &)`
+    [[nodiscard]] std::span<const meshlet_s> meshlets(const std::size_t lod = 0) const noexcept {
+        return std::span{m_meshlets}.subspan(m_lods[lod].first_meshlet, m_lods[lod].meshlet_count);
+    }
+    [[nodiscard]] std::uint32_t first_index(const meshlet_s &meshlet) const noexcept {
+        return m_geometry.first_index() + meshlet.first_index;
+    }
+
+    // the table of the mesh, uploaded with its geometry: `mesh_table_lod_s` for every level, then the meshlets
+    [[nodiscard]] vulkan::bindless_id_t table_id() const noexcept {
+        return m_geometry_pool.table_id(m_geometry.block);
+    }
+    [[nodiscard]] std::uint32_t first_table_element() const noexcept { return m_geometry.first_table_element(); }
 
 protected:
-    vk::Device m_device;
+    vulkan::GeometryPool &m_geometry_pool;
 
-    std::vector<vertex_s> m_vertices = {};
-    std::uint32_t m_vertex_count = 0;
-    vulkan::DeviceMemoryBuffer m_vertex_buffer;
+    vertex_format_e m_vertex_format;
+    bounding_sphere_s m_bounds;
+    glm::f32mat4 m_vertex_transform;
+    bounding_sphere_s m_vertex_bounds;
 
-    std::vector<std::uint32_t> m_indices = {};
-    bool m_exists_index_buffer = false;
-    std::uint32_t m_index_count = 0;
-    vulkan::DeviceMemoryBuffer m_index_buffer;
+    // before the geometry, which their table is uploaded with
+    std::vector<mesh_lod_s> m_lods;
+    std::vector<meshlet_s> m_meshlets;
+    vulkan::geometry_allocation_s m_geometry;
+    std::uint32_t m_vertex_count = 0;
 };
 
 namespace blanks {
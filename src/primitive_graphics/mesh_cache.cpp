@@ -0,0 +1,166 @@
+#include "mesh_cache.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace sm::arcane::primitive_graphics {
+
+namespace {
+
+[[nodiscard]] constexpr std::uint64_t align_up(const std::uint64_t value) noexcept {
+    return (value + g_mesh_cache_blob_alignment - 1) / g_mesh_cache_blob_alignment * g_mesh_cache_blob_alignment;
+}
+
+// a mesh without levels of detail is stored as its single level, so that readers find every level in one place
+[[nodiscard]] std::vector<mesh_lod_s> stored_lods(const mesh_data_s &mesh_data) {
+    if (!mesh_data.lods.empty()) {
+        return mesh_data.lods;
+    }
+    return {mesh_lod_s{.first_index = 0, .index_count = static_cast<std::uint32_t>(mesh_data.indices.size())}};
+}
+
+[[nodiscard]] mesh_cache_header_s make_header(const mesh_data_s &mesh_data,
+                                              const vertex_format_e vertex_format,
+                                              const std::uint64_t vertex_size,
+                                              const std::size_t lod_count) {
+    const auto [_, attributes] = vertex_input(vertex_format);
+    auto header = mesh_cache_header_s{.vertex_format = vertex_format,
+                                      .vertex_stride = vertex_stride(vertex_format),
+                                      .attribute_count = static_cast<std::uint32_t>(attributes.size()),
+                                      .vertex_count = static_cast<std::uint32_t>(mesh_data.vertices.size()),
+                                      .index_count = static_cast<std::uint32_t>(mesh_data.indices.size()),
+                                      .meshlet_count = static_cast<std::uint32_t>(mesh_data.meshlets.size()),
+                                      .lod_count = static_cast<std::uint32_t>(lod_count),
+                                      .aabb = compute_aabb(mesh_data.vertices),
+                                      .bounds = compute_bounds(mesh_data.vertices)};
+    for (auto i = std::size_t{0}; i < attributes.size(); ++i) {
+        header.attributes[i] = {.location = attributes[i].location,
+                                .format = attributes[i].format,
+                                .offset = attributes[i].offset};
+    }
+
+    header.vertices = {.offset = align_up(sizeof(mesh_cache_header_s)), .size = vertex_size};
+    header.indices = {.offset = align_up(header.vertices.offset + header.vertices.size),
+                      .size = mesh_data.indices.size() * sizeof(std::uint32_t)};
+    header.lods = {.offset = align_up(header.indices.offset + header.indices.size),
+                   .size = lod_count * sizeof(mesh_lod_s)};
+    header.meshlets = {.offset = align_up(header.lods.offset + header.lods.size),
+                       .size = mesh_data.meshlets.size() * sizeof(meshlet_s)};
+    return header;
+}
+
+void write_blob(std::ofstream &file, const mesh_cache_blob_s &blob, const std::span<const std::byte> bytes) {
+    static constexpr auto padding = std::array<char, g_mesh_cache_blob_alignment>{};
+    file.write(padding.data(), static_cast<std::streamsize>(blob.offset - static_cast<std::uint64_t>(file.tellp())));
+    file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+[[nodiscard]] bool is_valid_blob(const mesh_cache_blob_s &blob, const std::size_t file_size) noexcept {
+    return blob.offset % g_mesh_cache_blob_alignment == 0 && blob.offset <= file_size &&
+           blob.size <= file_size - blob.offset;
+}
+
+// the file must have been written with the layout this build draws the format with
+[[nodiscard]] bool has_current_vertex_layout(const mesh_cache_header_s &header) {
+    if (header.vertex_format != vertex_format_e::full && header.vertex_format != vertex_format_e::compact) {
+        return false;
+    }
+
+    const auto [_, attributes] = vertex_input(header.vertex_format);
+    if (header.vertex_stride != vertex_stride(header.vertex_format) || header.attribute_count != attributes.size()) {
+        return false;
+    }
+    return std::ranges::equal(attributes,
+                              std::span{header.attributes}.first(header.attribute_count),
+                              [](const vk::VertexInputAttributeDescription &expected,
+                                 const mesh_cache_attribute_s &stored) {
+                                  return expected.location == stored.location && expected.format == stored.format &&
+                                         expected.offset == stored.offset;
+                              });
+}
+
+} // namespace
+
+void write_mesh_cache(const std::filesystem::path &path,
+                      const mesh_data_s &mesh_data,
+                      const vertex_format_e vertex_format) {
+    if (mesh_data.vertices.size() < 3) {
+        throw std::runtime_error{"A mesh cache needs at least 3 vertices"};
+    }
+
+    const auto vertex_transform = compute_vertex_transform(compute_aabb(mesh_data.vertices), vertex_format);
+    const auto compact_vertices = vertex_format == vertex_format_e::compact
+                                          ? to_compact_vertices(mesh_data.vertices, vertex_transform)
+                                          : std::vector<compact_vertex_s>{};
+    const auto vertex_bytes = vertex_format == vertex_format_e::compact
+                                      ? std::as_bytes(std::span{compact_vertices})
+                                      : std::as_bytes(std::span{mesh_data.vertices});
+    const auto lods = stored_lods(mesh_data);
+    const auto header = make_header(mesh_data, vertex_format, vertex_bytes.size(), lods.size());
+
+    auto file = std::ofstream{path, std::ios::binary | std::ios::trunc};
+    if (!file.is_open()) {
+        throw std::runtime_error{"Failed to open the mesh cache file " + path.string() + " for writing"};
+    }
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    write_blob(file, header.vertices, vertex_bytes);
+    write_blob(file, header.indices, std::as_bytes(std::span{mesh_data.indices}));
+    write_blob(file, header.lods, std::as_bytes(std::span{lods}));
+    write_blob(file, header.meshlets, std::as_bytes(std::span{mesh_data.meshlets}));
+    if (!file) {
+        throw std::runtime_error{"Failed to write the mesh cache file " + path.string()};
+    }
+}
+
+MeshCache::MeshCache(const std::filesystem::path &path) : m_file{path} {
+    const auto bytes = m_file.bytes();
+    if (bytes.size() < sizeof(mesh_cache_header_s)) {
+        throw std::runtime_error{"The mesh cache file " + path.string() + " is truncated"};
+    }
+    // the mapping is page-aligned, which is enough for the header
+    m_header = reinterpret_cast<const mesh_cache_header_s *>(bytes.data());
+
+    if (m_header->magic != g_mesh_cache_magic || m_header->version != g_mesh_cache_version) {
+        throw std::runtime_error{"The file " + path.string() + " is not a mesh cache of version " +
+                                 std::to_string(g_mesh_cache_version)};
+    }
+    if (!has_current_vertex_layout(*m_header)) {
+        throw std::runtime_error{"The mesh cache file " + path.string() + " has an outdated vertex layout"};
+    }
+    if (!is_valid_blob(m_header->vertices, bytes.size()) || !is_valid_blob(m_header->indices, bytes.size()) ||
+        !is_valid_blob(m_header->lods, bytes.size()) || !is_valid_blob(m_header->meshlets, bytes.size()) ||
+        m_header->vertex_count < 3 || m_header->lod_count == 0 ||
+        m_header->vertices.size != std::uint64_t{m_header->vertex_count} * m_header->vertex_stride ||
+        m_header->indices.size != std::uint64_t{m_header->index_count} * sizeof(std::uint32_t) ||
+        m_header->lods.size != std::uint64_t{m_header->lod_count} * sizeof(mesh_lod_s) ||
+        m_header->meshlets.size != std::uint64_t{m_header->meshlet_count} * sizeof(meshlet_s) ||
+        !std::ranges::all_of(lods(), [this](const mesh_lod_s &lod) {
+            return std::uint64_t{lod.first_index} + lod.index_count <= m_header->index_count &&
+                   std::uint64_t{lod.first_meshlet} + lod.meshlet_count <= m_header->meshlet_count;
+        }) ||
+        !std::ranges::all_of(meshlets(), [this](const meshlet_s &meshlet) {
+            return std::uint64_t{meshlet.first_index} + meshlet.index_count <= m_header->index_count;
+        })) {
+        throw std::runtime_error{"The mesh cache file " + path.string() + " is corrupted"};
+    }
+}
+
+std::span<const std::uint32_t> MeshCache::indices() const noexcept {
+    const auto bytes = blob(m_header->indices);
+    return {reinterpret_cast<const std::uint32_t *>(bytes.data()), bytes.size() / sizeof(std::uint32_t)};
+}
+
+std::span<const mesh_lod_s> MeshCache::lods() const noexcept {
+    const auto bytes = blob(m_header->lods);
+    return {reinterpret_cast<const mesh_lod_s *>(bytes.data()), bytes.size() / sizeof(mesh_lod_s)};
+}
+
+std::span<const meshlet_s> MeshCache::meshlets() const noexcept {
+    const auto bytes = blob(m_header->meshlets);
+    return {reinterpret_cast<const meshlet_s *>(bytes.data()), bytes.size() / sizeof(meshlet_s)};
+}
+
+} // namespace sm::arcane::primitive_graphics
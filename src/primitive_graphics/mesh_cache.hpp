@@ -0,0 +1,104 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <type_traits>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "primitive_graphics/mesh_data.hpp"
+#include "primitive_graphics/vertex_format.hpp"
+#include "util/mapped_file.hpp"
+
+namespace sm::arcane::primitive_graphics {
+
+// "ARCM" in a little-endian file
+inline constexpr auto g_mesh_cache_magic = std::uint32_t{0x4d435241};
+// bumped whenever the layout of the file or of a vertex format changes
+inline constexpr auto g_mesh_cache_version = std::uint32_t{3};
+// of every blob, from the start of the file: wider than any element, and a cache line
+inline constexpr auto g_mesh_cache_blob_alignment = std::uint64_t{64};
+inline constexpr auto g_mesh_cache_max_attribute_count = std::size_t{4};
+
+// in bytes, from the start of the file
+struct mesh_cache_blob_s {
+    std::uint64_t offset = 0;
+    std::uint64_t size = 0;
+};
+
+struct mesh_cache_attribute_s {
+    std::uint32_t location = 0;
+    vk::Format format = vk::Format::eUndefined;
+    std::uint32_t offset = 0;
+};
+
+// The start of a mesh cache file, followed by the blobs it points at. Everything is stored exactly as it is consumed:
+// the vertices already in `vertex_format`, the indices as 32-bit, so a mapped file is uploaded with no parsing or
+// conversion. Little-endian, as every platform the engine runs on
+struct mesh_cache_header_s {
+    std::uint32_t magic = g_mesh_cache_magic;
+    std::uint32_t version = g_mesh_cache_version;
+
+    // the vertex layout, checked against `vertex_input(vertex_format)` when the file is opened
+    vertex_format_e vertex_format = vertex_format_e::full;
+    std::uint32_t vertex_stride = 0;
+    std::uint32_t attribute_count = 0;
+    std::array<mesh_cache_attribute_s, g_mesh_cache_max_attribute_count> attributes{};
+
+    std::uint32_t vertex_count = 0;
+    std::uint32_t index_count = 0;
+    std::uint32_t meshlet_count = 0;
+    // at least one: a file of a single level lists it as well
+    std::uint32_t lod_count = 0;
+    std::uint32_t reserved = 0;
+
+    // of the source positions; also what `compute_vertex_transform` dequantizes compact positions with
+    aabb_s aabb;
+    bounding_sphere_s bounds;
+
+    mesh_cache_blob_s vertices;
+    mesh_cache_blob_s indices;
+    // `mesh_lod_s` each, the finest first
+    mesh_cache_blob_s lods;
+    // `meshlet_s` each, in the order of the levels they split; empty when none were built
+    mesh_cache_blob_s meshlets;
+};
+static_assert(std::is_trivially_copyable_v<mesh_cache_header_s>);
+static_assert(sizeof(mesh_cache_header_s) == 192);
+static_assert(std::is_trivially_copyable_v<mesh_lod_s>);
+static_assert(std::is_trivially_copyable_v<meshlet_s>);
+
+// the offline side: encodes `mesh_data` into `vertex_format` and writes the file. Throws `std::runtime_error` on
+// failure
+void write_mesh_cache(const std::filesystem::path &path, const mesh_data_s &mesh_data, vertex_format_e vertex_format);
+
+// A mesh cache file mapped into memory. The header is validated once when the file is opened, then the views point
+// straight into the mapping: `Mesh` copies them into staging memory without an intermediate copy. Throws
+// `std::runtime_error` when the file is not a valid cache of the current version
+class MeshCache {
+public:
+    explicit MeshCache(const std::filesystem::path &path);
+
+    [[nodiscard]] const mesh_cache_header_s &header() const noexcept { return *m_header; }
+
+    [[nodiscard]] std::span<const std::byte> vertices() const noexcept { return blob(m_header->vertices); }
+    [[nodiscard]] std::span<const std::uint32_t> indices() const noexcept;
+    [[nodiscard]] std::span<const mesh_lod_s> lods() const noexcept;
+    [[nodiscard]] std::span<const meshlet_s> meshlets() const noexcept;
+
+private:
+    [[nodiscard]] std::span<const std::byte> blob(const mesh_cache_blob_s &blob) const noexcept {
+        return m_file.bytes().subspan(blob.offset, blob.size);
+    }
+
+    util::MappedFile m_file;
+    const mesh_cache_header_s *m_header = nullptr;
+};
+
+} // namespace sm::arcane::primitive_graphics
@@ -0,0 +1,68 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "primitive_graphics/vertex_format.hpp"
+#include "util/hash.hpp"
+
+namespace sm::arcane::primitive_graphics {
+
+// a level of detail: a range of `mesh_data_s::indices`, over the same vertices as every other level
+struct mesh_lod_s {
+    std::uint32_t first_index = 0;
+    std::uint32_t index_count = 0;
+    // how far the simplified surface may be from the source one, in the local space of the mesh
+    float error = 0.0f;
+    // the clusters the level is split into, a range of `mesh_data_s::meshlets`; empty until they are built
+    std::uint32_t first_meshlet = 0;
+    std::uint32_t meshlet_count = 0;
+};
+
+// A cluster of nearby triangles of one level of detail, culled as a whole: a range of `mesh_data_s::indices` with
+// its bounds. The layout is the one `cull_meshlets.comp` reads (std430)
+struct meshlet_s {
+    // the bounding sphere of the cluster, in the local space of the mesh
+    glm::f32vec3 center;
+    float radius = 0.0f;
+    // the cone around the normals of the triangles as `snorm8x4`, `xyz` the axis, `w` the sine of the half angle:
+    // every triangle faces away from a camera at `p` when
+    // `dot(center - p, axis) >= w * length(center - p) + radius`; `w` is 1 when the cone is too wide to cull with
+    std::uint32_t cone = 0;
+    std::uint32_t first_index = 0;
+    std::uint32_t index_count = 0;
+    // the distinct vertices the cluster references
+    std::uint32_t vertex_count = 0;
+};
+static_assert(sizeof(meshlet_s) == 32);
+
+// The CPU side of a mesh: what loaders produce and what `Mesh` copies into the geometry pool
+struct mesh_data_s {
+    std::vector<vertex_s> vertices;
+    // a triangle list, or one per level of detail one after another
+    std::vector<std::uint32_t> indices;
+    // the finest first; empty means a single level made of every index
+    std::vector<mesh_lod_s> lods;
+    std::vector<meshlet_s> meshlets;
+};
+
+// for deduplicating vertices; consistent with `vertex_s::operator==`
+struct vertex_hash_s {
+    [[nodiscard]] std::size_t operator()(const vertex_s &vertex) const noexcept {
+        auto seed = std::size_t{0};
+        for (auto i = 0; i < 3; ++i) {
+            util::hash_combine(seed, vertex.position[i]);
+            util::hash_combine(seed, vertex.normal[i]);
+        }
+        for (auto i = 0; i < 4; ++i) {
+            util::hash_combine(seed, vertex.color[i]);
+        }
+        return seed;
+    }
+};
+
+} // namespace sm::arcane::primitive_graphics
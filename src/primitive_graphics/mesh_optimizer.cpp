@@ -0,0 +1,353 @@
+#include "mesh_optimizer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include <glm/geometric.hpp>
+
+namespace sm::arcane::primitive_graphics {
+
+namespace {
+
+// A FIFO cache of vertex indices kept as insertion timestamps: a vertex is cached when fewer than `cache_size` misses
+// happened since it was inserted, so an access is O(1) whatever the cache size
+class VertexCache {
+public:
+    VertexCache(const std::size_t vertex_count, const std::uint32_t cache_size)
+        : m_timestamps(vertex_count, 0),
+          m_time{cache_size + 1},
+          m_cache_size{cache_size} {}
+
+    [[nodiscard]] bool contains(const std::uint32_t vertex) const noexcept {
+        return m_time - m_timestamps[vertex] <= m_cache_size;
+    }
+    // how many misses ago the vertex was inserted
+    [[nodiscard]] std::uint32_t age(const std::uint32_t vertex) const noexcept { return m_time - m_timestamps[vertex]; }
+
+    // returns whether it was a miss
+    bool access(const std::uint32_t vertex) noexcept {
+        if (contains(vertex)) {
+            return false;
+        }
+        m_timestamps[vertex] = m_time++;
+        return true;
+    }
+
+    void clear() noexcept { m_time += m_cache_size + 1; }
+
+private:
+    std::vector<std::uint32_t> m_timestamps;
+    std::uint32_t m_time;
+    std::uint32_t m_cache_size;
+};
+
+[[nodiscard]] std::uint32_t access_triangle(VertexCache &cache,
+                                            const std::span<const std::uint32_t> indices,
+                                            const std::size_t triangle) noexcept {
+    auto misses = std::uint32_t{0};
+    for (auto corner = std::size_t{0}; corner < 3; ++corner) {
+        misses += cache.access(indices[triangle * 3 + corner]) ? 1 : 0;
+    }
+    return misses;
+}
+
+// the triangles of a vertex, as one array sliced by per-vertex offsets
+struct vertex_triangles_s {
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> triangles;
+
+    [[nodiscard]] std::span<const std::uint32_t> of(const std::uint32_t vertex) const noexcept {
+        return std::span{triangles}.subspan(offsets[vertex], offsets[vertex + 1] - offsets[vertex]);
+    }
+};
+
+[[nodiscard]] vertex_triangles_s build_vertex_triangles(const std::span<const std::uint32_t> indices,
+                                                        const std::size_t vertex_count) {
+    auto vertex_triangles = vertex_triangles_s{.offsets = std::vector<std::uint32_t>(vertex_count + 1, 0),
+                                               .triangles = std::vector<std::uint32_t>(indices.size())};
+    for (const auto index : indices) {
+        ++vertex_triangles.offsets[index + 1];
+    }
+    std::partial_sum(vertex_triangles.offsets.begin(),
+                     vertex_triangles.offsets.end(),
+                     vertex_triangles.offsets.begin());
+
+    auto cursors = std::vector<std::uint32_t>(vertex_triangles.offsets.begin(), vertex_triangles.offsets.end() - 1);
+    for (auto i = std::size_t{0}; i < indices.size(); ++i) {
+        vertex_triangles.triangles[cursors[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+    }
+    return vertex_triangles;
+}
+
+struct cluster_s {
+    std::size_t first_triangle = 0;
+    std::size_t triangle_count = 0;
+    float sort_key = 0.0f;
+};
+
+// a cluster starts where the cache order jumps elsewhere (a triangle with no cached vertex), or where the triangles
+// since the previous start, replayed from a cold cache, are already within `threshold` of their part's ACMR: starting
+// from a cold cache there is exactly what a cluster costs once it is moved
+[[nodiscard]] std::vector<cluster_s> split_clusters(const std::span<const std::uint32_t> indices,
+                                                    const std::size_t vertex_count,
+                                                    const std::uint32_t cache_size,
+                                                    const float threshold) {
+    const auto triangle_count = indices.size() / 3;
+
+    auto hard_starts = std::vector<std::size_t>{0};
+    auto cache = VertexCache{vertex_count, cache_size};
+    for (auto triangle = std::size_t{0}; triangle < triangle_count; ++triangle) {
+        if (access_triangle(cache, indices, triangle) == 3 && triangle > 0) {
+            hard_starts.push_back(triangle);
+        }
+    }
+    hard_starts.push_back(triangle_count);
+
+    auto clusters = std::vector<cluster_s>{};
+    for (auto part = std::size_t{0}; part + 1 < hard_starts.size(); ++part) {
+        const auto first = hard_starts[part];
+        const auto last = hard_starts[part + 1];
+
+        cache.clear();
+        auto part_misses = std::uint32_t{0};
+        for (auto triangle = first; triangle < last; ++triangle) {
+            part_misses += access_triangle(cache, indices, triangle);
+        }
+        const auto max_acmr = threshold * static_cast<float>(part_misses) / static_cast<float>(last - first);
+
+        cache.clear();
+        auto cluster = cluster_s{.first_triangle = first};
+        auto cluster_misses = std::uint32_t{0};
+        for (auto triangle = first; triangle < last; ++triangle) {
+            cluster_misses += access_triangle(cache, indices, triangle);
+            ++cluster.triangle_count;
+            if (triangle + 1 < last &&
+                static_cast<float>(cluster_misses) <= max_acmr * static_cast<float>(cluster.triangle_count)) {
+                clusters.push_back(cluster);
+                cluster = cluster_s{.first_triangle = triangle + 1};
+                cluster_misses = 0;
+                cache.clear();
+            }
+        }
+        clusters.push_back(cluster);
+    }
+    return clusters;
+}
+
+} // namespace
+
+vertex_cache_stats_s analyze_vertex_cache(const std::span<const std::uint32_t> indices,
+                                          const std::size_t vertex_count,
+                                          const std::uint32_t cache_size) {
+    assert(indices.size() % 3 == 0);
+    if (indices.empty()) {
+        return {};
+    }
+
+    auto cache = VertexCache{vertex_count, cache_size};
+    auto is_referenced = std::vector<bool>(vertex_count, false);
+    auto misses = std::size_t{0};
+    auto referenced_count = std::size_t{0};
+    for (const auto index : indices) {
+        misses += cache.access(index) ? 1 : 0;
+        if (!is_referenced[index]) {
+            is_referenced[index] = true;
+            ++referenced_count;
+        }
+    }
+    return {.acmr = static_cast<float>(misses) / static_cast<float>(indices.size() / 3),
+            .atvr = static_cast<float>(misses) / static_cast<float>(referenced_count)};
+}
+
+void optimize_vertex_cache(const std::span<std::uint32_t> indices,
+                           const std::size_t vertex_count,
+                           const std::uint32_t cache_size) {
+    assert(indices.size() % 3 == 0);
+    if (indices.empty()) {
+        return;
+    }
+
+    const auto vertex_triangles = build_vertex_triangles(indices, vertex_count);
+    auto live_triangle_counts = std::vector<std::uint32_t>(vertex_count);
+    for (auto vertex = std::size_t{0}; vertex < vertex_count; ++vertex) {
+        live_triangle_counts[vertex] = vertex_triangles.offsets[vertex + 1] - vertex_triangles.offsets[vertex];
+    }
+
+    auto cache = VertexCache{vertex_count, cache_size};
+    auto is_emitted = std::vector<bool>(indices.size() / 3, false);
+    // the vertices of the emitted triangles, most recent last: the first place to look for a vertex with live
+    // triangles once the candidates are all dead
+    auto dead_end_stack = std::vector<std::uint32_t>{};
+    auto candidates = std::vector<std::uint32_t>{};
+    auto output = std::vector<std::uint32_t>{};
+    output.reserve(indices.size());
+    auto input_cursor = std::uint32_t{0};
+
+    constexpr auto no_vertex = std::numeric_limits<std::uint32_t>::max();
+    const auto skip_dead_end = [&]() -> std::uint32_t {
+        while (!dead_end_stack.empty()) {
+            const auto vertex = dead_end_stack.back();
+            dead_end_stack.pop_back();
+            if (live_triangle_counts[vertex] > 0) {
+                return vertex;
+            }
+        }
+        for (; input_cursor < vertex_count; ++input_cursor) {
+            if (live_triangle_counts[input_cursor] > 0) {
+                return input_cursor;
+            }
+        }
+        return no_vertex;
+    };
+
+    for (auto fanning_vertex = skip_dead_end(); fanning_vertex != no_vertex;) {
+        candidates.clear();
+        for (const auto triangle : vertex_triangles.of(fanning_vertex)) {
+            if (is_emitted[triangle]) {
+                continue;
+            }
+            for (auto corner = std::size_t{0}; corner < 3; ++corner) {
+                const auto vertex = indices[triangle * 3 + corner];
+                output.push_back(vertex);
+                dead_end_stack.push_back(vertex);
+                candidates.push_back(vertex);
+                --live_triangle_counts[vertex];
+                cache.access(vertex);
+            }
+            is_emitted[triangle] = true;
+        }
+
+        // the oldest candidate that is still cached after its remaining triangles are emitted (each of them adds at
+        // most two vertices to the cache)
+        auto next_vertex = no_vertex;
+        auto max_age = std::uint32_t{0};
+        for (const auto vertex : candidates) {
+            if (live_triangle_counts[vertex] == 0) {
+                continue;
+            }
+            const auto age = cache.age(vertex);
+            if (age + 2 * live_triangle_counts[vertex] <= cache_size && age > max_age) {
+                max_age = age;
+                next_vertex = vertex;
+            }
+        }
+        fanning_vertex = next_vertex != no_vertex ? next_vertex : skip_dead_end();
+    }
+
+    std::ranges::copy(output, indices.begin());
+}
+
+void optimize_overdraw(const std::span<std::uint32_t> indices,
+                       const std::span<const vertex_s> vertices,
+                       const std::uint32_t cache_size,
+                       const float threshold) {
+    assert(indices.size() % 3 == 0);
+    const auto triangle_count = indices.size() / 3;
+    if (triangle_count < 2) {
+        return;
+    }
+
+    auto clusters = split_clusters(indices, vertices.size(), cache_size, threshold);
+
+    // the area-weighted centroid and normal of every cluster; the cross products already weigh by area
+    auto centroids = std::vector<glm::f32vec3>(clusters.size(), glm::f32vec3{0.0f});
+    auto normals = std::vector<glm::f32vec3>(clusters.size(), glm::f32vec3{0.0f});
+    auto areas = std::vector<float>(clusters.size(), 0.0f);
+    auto mesh_centroid = glm::f32vec3{0.0f};
+    auto mesh_area = 0.0f;
+    for (auto i = std::size_t{0}; i < clusters.size(); ++i) {
+        for (auto triangle = clusters[i].first_triangle;
+             triangle < clusters[i].first_triangle + clusters[i].triangle_count;
+             ++triangle) {
+            const auto &p0 = vertices[indices[triangle * 3]].position;
+            const auto &p1 = vertices[indices[triangle * 3 + 1]].position;
+            const auto &p2 = vertices[indices[triangle * 3 + 2]].position;
+            const auto normal = glm::cross(p1 - p0, p2 - p0);
+            const auto area = glm::length(normal);
+            centroids[i] += (p0 + p1 + p2) * (area / 3.0f);
+            normals[i] += normal;
+            areas[i] += area;
+        }
+        mesh_centroid += centroids[i];
+        mesh_area += areas[i];
+    }
+    if (mesh_area > 0.0f) {
+        mesh_centroid /= mesh_area;
+    }
+
+    for (auto i = std::size_t{0}; i < clusters.size(); ++i) {
+        const auto normal_length = glm::length(normals[i]);
+        if (areas[i] > 0.0f && normal_length > 0.0f) {
+            clusters[i].sort_key = glm::dot(centroids[i] / areas[i] - mesh_centroid, normals[i] / normal_length);
+        }
+    }
+    // the clusters facing away from the center are the likeliest to occlude the others
+    std::ranges::stable_sort(clusters, std::ranges::greater{}, &cluster_s::sort_key);
+
+    auto output = std::vector<std::uint32_t>{};
+    output.reserve(indices.size());
+    for (const auto &cluster : clusters) {
+        const auto first = indices.begin() + static_cast<std::ptrdiff_t>(cluster.first_triangle * 3);
+        output.insert(output.end(), first, first + static_cast<std::ptrdiff_t>(cluster.triangle_count * 3));
+    }
+    std::ranges::copy(output, indices.begin());
+}
+
+void optimize_vertex_fetch(mesh_data_s &mesh_data) {
+    constexpr auto unmapped = std::numeric_limits<std::uint32_t>::max();
+    auto remap = std::vector<std::uint32_t>(mesh_data.vertices.size(), unmapped);
+    auto vertices = std::vector<vertex_s>{};
+    vertices.reserve(mesh_data.vertices.size());
+    for (auto &index : mesh_data.indices) {
+        if (remap[index] == unmapped) {
+            remap[index] = static_cast<std::uint32_t>(vertices.size());
+            vertices.push_back(mesh_data.vertices[index]);
+        }
+        index = remap[index];
+    }
+    mesh_data.vertices = std::move(vertices);
+}
+
+mesh_optimization_report_s optimize_mesh(mesh_data_s &mesh_data, const mesh_optimization_options_s &options) {
+    assert(std::ranges::all_of(mesh_data.indices,
+                               [&mesh_data](const std::uint32_t index) { return index < mesh_data.vertices.size(); }));
+
+    // each level of detail is drawn on its own, so each is ordered on its own
+    const auto index_count = static_cast<std::uint32_t>(mesh_data.indices.size());
+    const auto lods = mesh_data.lods.empty() ? std::vector{mesh_lod_s{.index_count = index_count}} : mesh_data.lods;
+    const auto lod_indices = [&mesh_data](const mesh_lod_s &lod) {
+        return std::span{mesh_data.indices}.subspan(lod.first_index, lod.index_count);
+    };
+
+    auto report = mesh_optimization_report_s{};
+    report.before = analyze_vertex_cache(lod_indices(lods.front()), mesh_data.vertices.size(), options.cache_size);
+
+    for (const auto &lod : lods) {
+        optimize_vertex_cache(lod_indices(lod), mesh_data.vertices.size(), options.cache_size);
+        if (options.optimize_overdraw) {
+            optimize_overdraw(lod_indices(lod), mesh_data.vertices, options.cache_size, options.overdraw_threshold);
+        }
+    }
+    // last: it only renames the vertices, which keeps the cache behavior of the order above. The finest level comes
+    // first and references every vertex the coarser ones do, so their fetches walk forward as well
+    optimize_vertex_fetch(mesh_data);
+
+    report.after = analyze_vertex_cache(lod_indices(lods.front()), mesh_data.vertices.size(), options.cache_size);
+    return report;
+}
+
+void log_mesh_optimization_report(spdlog::logger &logger,
+                                  const std::string_view mesh_name,
+                                  const mesh_optimization_report_s &report) {
+    logger.info("{}: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+                mesh_name,
+                report.before.acmr,
+                report.after.acmr,
+                report.before.atvr,
+                report.after.atvr);
+}
+
+} // namespace sm::arcane::primitive_graphics
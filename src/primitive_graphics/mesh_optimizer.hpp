@@ -0,0 +1,71 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include <spdlog/logger.h>
+
+#include "primitive_graphics/mesh_data.hpp"
+
+namespace sm::arcane::primitive_graphics {
+
+// the FIFO post-transform cache every pass optimizes for and every metric is measured with: small enough to stay a
+// good proxy for the batched vertex reuse of current GPUs
+inline constexpr auto g_default_vertex_cache_size = std::uint32_t{16};
+
+struct vertex_cache_stats_s {
+    // average cache miss ratio: vertex shader invocations per triangle, from 0.5 (ideal grid) to 3
+    float acmr = 0.0f;
+    // average transform to vertex ratio: vertex shader invocations per referenced vertex, 1 at best
+    float atvr = 0.0f;
+};
+
+struct mesh_optimization_options_s {
+    std::uint32_t cache_size = g_default_vertex_cache_size;
+    // sorts clusters of triangles so that the ones facing outwards are drawn first, which trades a bit of vertex cache
+    // efficiency for less overdraw
+    bool optimize_overdraw = false;
+    // how much worse the ACMR of the overdraw order may get, as a factor
+    float overdraw_threshold = 1.05f;
+};
+
+struct mesh_optimization_report_s {
+    vertex_cache_stats_s before;
+    vertex_cache_stats_s after;
+};
+
+[[nodiscard]] vertex_cache_stats_s analyze_vertex_cache(std::span<const std::uint32_t> indices,
+                                                        std::size_t vertex_count,
+                                                        std::uint32_t cache_size = g_default_vertex_cache_size);
+
+// Tipsify (Sander, Nehab, Barczak, "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw", 2007): fans
+// triangles around the vertex most likely to still be in the cache, in linear time. `indices` is a triangle list
+void optimize_vertex_cache(std::span<std::uint32_t> indices,
+                           std::size_t vertex_count,
+                           std::uint32_t cache_size = g_default_vertex_cache_size);
+
+// Splits a cache-optimized triangle list into clusters wherever a cluster can start without costing more than
+// `threshold` of the ACMR, then sorts the clusters from the most outward-facing to the least
+void optimize_overdraw(std::span<std::uint32_t> indices,
+                       std::span<const vertex_s> vertices,
+                       std::uint32_t cache_size = g_default_vertex_cache_size,
+                       float threshold = 1.05f);
+
+// Renumbers the vertices in the order the indices first reference them, so vertex fetches walk memory forward;
+// vertices no index refers to are dropped
+void optimize_vertex_fetch(mesh_data_s &mesh_data);
+
+// Every pass above in order, for imported meshes: the triangle order passes run on every level of detail on its own.
+// The report is about the finest level
+mesh_optimization_report_s optimize_mesh(mesh_data_s &mesh_data, const mesh_optimization_options_s &options = {});
+
+void log_mesh_optimization_report(spdlog::logger &logger,
+                                  std::string_view mesh_name,
+                                  const mesh_optimization_report_s &report);
+
+} // namespace sm::arcane::primitive_graphics
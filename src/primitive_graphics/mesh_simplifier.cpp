@@ -0,0 +1,357 @@
+#include "mesh_simplifier.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+#include <glm/geometric.hpp>
+
+#include "util/hash.hpp"
+
+namespace sm::arcane::primitive_graphics {
+
+namespace {
+
+// the sum of the squared distances to a set of planes, each weighted by the area of its triangle; evaluated in double
+// precision, since the terms cancel out near the surface
+struct quadric_s {
+    double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+    double b2 = 0.0, bc = 0.0, bd = 0.0;
+    double c2 = 0.0, cd = 0.0;
+    double d2 = 0.0;
+    double weight = 0.0;
+
+    [[nodiscard]] static quadric_s from_triangle(const glm::f32vec3 &p0,
+                                                 const glm::f32vec3 &p1,
+                                                 const glm::f32vec3 &p2) noexcept {
+        const auto normal = glm::cross(p1 - p0, p2 - p0);
+        const auto area = static_cast<double>(glm::length(normal));
+        if (area == 0.0) {
+            return {};
+        }
+
+        const auto a = static_cast<double>(normal.x) / area;
+        const auto b = static_cast<double>(normal.y) / area;
+        const auto c = static_cast<double>(normal.z) / area;
+        const auto d = -(a * p0.x + b * p0.y + c * p0.z);
+        return {a * a * area, a * b * area, a * c * area, a * d * area,
+                b * b * area, b * c * area, b * d * area,
+                c * c * area, c * d * area,
+                d * d * area,
+                area};
+    }
+
+    quadric_s &operator+=(const quadric_s &other) noexcept {
+        a2 += other.a2, ab += other.ab, ac += other.ac, ad += other.ad;
+        b2 += other.b2, bc += other.bc, bd += other.bd;
+        c2 += other.c2, cd += other.cd;
+        d2 += other.d2;
+        weight += other.weight;
+        return *this;
+    }
+
+    [[nodiscard]] quadric_s operator+(const quadric_s &other) const noexcept {
+        auto sum = *this;
+        return sum += other;
+    }
+
+    // the mean squared distance to the planes
+    [[nodiscard]] double error(const glm::f32vec3 &point) const noexcept {
+        if (weight == 0.0) {
+            return 0.0;
+        }
+        const auto x = static_cast<double>(point.x);
+        const auto y = static_cast<double>(point.y);
+        const auto z = static_cast<double>(point.z);
+        const auto squared = a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x + b2 * y * y +
+                             2.0 * bc * y * z + 2.0 * bd * y + c2 * z * z + 2.0 * cd * z + d2;
+        return std::max(squared, 0.0) / weight;
+    }
+};
+
+struct position_hash_s {
+    [[nodiscard]] std::size_t operator()(const glm::f32vec3 &position) const noexcept {
+        auto seed = std::size_t{0};
+        util::hash_combine(seed, position.x);
+        util::hash_combine(seed, position.y);
+        util::hash_combine(seed, position.z);
+        return seed;
+    }
+};
+
+// the vertices that must keep their place: at a seam, since its other vertices would have to follow with their own
+// attributes, or on an open border, whose shape would shrink. Borders are found by position, so that a seam isn't one
+[[nodiscard]] std::vector<bool> find_locked_vertices(const std::span<const vertex_s> vertices,
+                                                     const std::span<const std::uint32_t> indices) {
+    auto first_vertices = std::unordered_map<glm::f32vec3, std::uint32_t, position_hash_s>{};
+    auto positions = std::vector<std::uint32_t>(vertices.size());
+    auto wedge_counts = std::vector<std::uint32_t>(vertices.size(), 0);
+    for (auto vertex = std::uint32_t{0}; vertex < vertices.size(); ++vertex) {
+        const auto [it, _] = first_vertices.try_emplace(vertices[vertex].position, vertex);
+        positions[vertex] = it->second;
+        ++wedge_counts[it->second];
+    }
+
+    auto edge_counts = std::unordered_map<std::uint64_t, std::uint32_t>{};
+    for (auto i = std::size_t{0}; i < indices.size(); i += 3) {
+        for (auto corner = std::size_t{0}; corner < 3; ++corner) {
+            const auto a = positions[indices[i + corner]];
+            const auto b = positions[indices[i + (corner + 1) % 3]];
+            ++edge_counts[std::uint64_t{std::min(a, b)} << 32 | std::max(a, b)];
+        }
+    }
+
+    auto is_locked = std::vector<bool>(vertices.size(), false);
+    for (auto vertex = std::size_t{0}; vertex < vertices.size(); ++vertex) {
+        is_locked[vertex] = wedge_counts[positions[vertex]] > 1;
+    }
+    for (const auto &[edge, count] : edge_counts) {
+        if (count == 1) {
+            is_locked[edge >> 32] = true;
+            is_locked[edge & 0xffffffff] = true;
+        }
+    }
+    // the positions were locked above, their vertices are locked through them
+    for (auto vertex = std::size_t{0}; vertex < vertices.size(); ++vertex) {
+        is_locked[vertex] = is_locked[vertex] || is_locked[positions[vertex]];
+    }
+    return is_locked;
+}
+
+struct collapse_s {
+    std::uint32_t from = 0;
+    std::uint32_t to = 0;
+    double error = 0.0;
+};
+
+// whether moving `from` onto `to` turns any of the triangles around `from` over, or folds it onto an edge
+[[nodiscard]] bool flips_triangles(const std::span<const vertex_s> vertices,
+                                   const std::span<const std::uint32_t> indices,
+                                   const std::span<const std::uint32_t> from_triangles,
+                                   const collapse_s &collapse) noexcept {
+    const auto &target = vertices[collapse.to].position;
+    for (const auto triangle : from_triangles) {
+        const auto *const corners = &indices[triangle * 3];
+        if (corners[0] == collapse.to || corners[1] == collapse.to || corners[2] == collapse.to) {
+            continue;
+        }
+
+        const auto &p0 = vertices[corners[0]].position;
+        const auto &p1 = vertices[corners[1]].position;
+        const auto &p2 = vertices[corners[2]].position;
+        const auto normal = glm::cross(p1 - p0, p2 - p0);
+        const auto moved = [&](const std::size_t corner) -> const glm::f32vec3 & {
+            return corners[corner] == collapse.from ? target : vertices[corners[corner]].position;
+        };
+        const auto moved_normal = glm::cross(moved(1) - moved(0), moved(2) - moved(0));
+        if (glm::dot(normal, moved_normal) <= 0.25f * glm::length(normal) * glm::length(moved_normal)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// How far the surface gets from the source one once `from` is moved onto `to`: the distance of where `from` was to the
+// nearest plane of the triangles moved with it, which is where the surface moves the most, added to how far both
+// vertices already were. Unlike the mean distance of the quadrics, it doesn't shrink as the planes around add up
+[[nodiscard]] float collapse_error(const std::span<const vertex_s> vertices,
+                                   const std::span<const std::uint32_t> indices,
+                                   const std::span<const std::uint32_t> from_triangles,
+                                   const std::span<const float> vertex_errors,
+                                   const collapse_s &collapse) noexcept {
+    const auto &source = vertices[collapse.from].position;
+    auto distance = std::numeric_limits<float>::max();
+    for (const auto triangle : from_triangles) {
+        const auto *const corners = &indices[triangle * 3];
+        if (corners[0] == collapse.to || corners[1] == collapse.to || corners[2] == collapse.to) {
+            // collapsed away
+            continue;
+        }
+
+        const auto moved = [&](const std::size_t corner) -> const glm::f32vec3 & {
+            return vertices[corners[corner] == collapse.from ? collapse.to : corners[corner]].position;
+        };
+        const auto normal = glm::cross(moved(1) - moved(0), moved(2) - moved(0));
+        if (const auto area = glm::length(normal); area > 0.0f) {
+            distance = std::min(distance, std::abs(glm::dot(normal, source - moved(0))) / area);
+        }
+    }
+    if (distance == std::numeric_limits<float>::max()) {
+        // no triangle is left around `from` to move
+        distance = 0.0f;
+    }
+    return std::max(vertex_errors[collapse.from], vertex_errors[collapse.to]) + distance;
+}
+
+} // namespace
+
+simplified_indices_s simplify(const std::span<const vertex_s> vertices,
+                              const std::span<const std::uint32_t> indices,
+                              const std::size_t target_index_count,
+                              const float max_error) {
+    assert(indices.size() % 3 == 0);
+
+    auto result = simplified_indices_s{.indices = {indices.begin(), indices.end()}, .error = 0.0f};
+    const auto is_locked = find_locked_vertices(vertices, indices);
+    const auto max_squared_error = static_cast<double>(max_error) * static_cast<double>(max_error);
+
+    auto quadrics = std::vector<quadric_s>(vertices.size());
+    for (auto i = std::size_t{0}; i < indices.size(); i += 3) {
+        const auto quadric = quadric_s::from_triangle(vertices[indices[i]].position,
+                                                      vertices[indices[i + 1]].position,
+                                                      vertices[indices[i + 2]].position);
+        for (auto corner = std::size_t{0}; corner < 3; ++corner) {
+            quadrics[indices[i + corner]] += quadric;
+        }
+    }
+
+    // how far the surface around each vertex is from the source one, as of the collapses onto it
+    auto vertex_errors = std::vector<float>(vertices.size(), 0.0f);
+    auto collapses = std::vector<collapse_s>{};
+    auto triangle_offsets = std::vector<std::uint32_t>(vertices.size() + 1);
+    auto vertex_triangles = std::vector<std::uint32_t>{};
+    auto is_touched = std::vector<bool>{};
+    auto remap = std::vector<std::uint32_t>(vertices.size());
+
+    // Every pass collapses the cheapest edges first, at most one collapse around each vertex, since every check of a
+    // collapse assumes the triangles around it are as they were when the pass started
+    while (result.indices.size() > target_index_count) {
+        auto &current = result.indices;
+
+        collapses.clear();
+        for (auto i = std::size_t{0}; i < current.size(); i += 3) {
+            for (auto corner = std::size_t{0}; corner < 3; ++corner) {
+                const auto a = current[i + corner];
+                const auto b = current[i + (corner + 1) % 3];
+                // each edge of a closed surface is in two triangles; only one of them proposes it. The mean squared
+                // distance of the quadrics orders the collapses; none is kept whose mean is already too large
+                if (a > b) {
+                    continue;
+                }
+                const auto quadric = quadrics[a] + quadrics[b];
+                auto collapse = collapse_s{.error = std::numeric_limits<double>::max()};
+                if (!is_locked[a]) {
+                    collapse = {.from = a, .to = b, .error = quadric.error(vertices[b].position)};
+                }
+                if (!is_locked[b]) {
+                    if (const auto error = quadric.error(vertices[a].position); error < collapse.error) {
+                        collapse = {.from = b, .to = a, .error = error};
+                    }
+                }
+                if (collapse.error <= max_squared_error) {
+                    collapses.push_back(collapse);
+                }
+            }
+        }
+        if (collapses.empty()) {
+            break;
+        }
+        std::ranges::sort(collapses, {}, &collapse_s::error);
+
+        std::ranges::fill(triangle_offsets, 0);
+        for (const auto index : current) {
+            ++triangle_offsets[index + 1];
+        }
+        for (auto vertex = std::size_t{0}; vertex < vertices.size(); ++vertex) {
+            triangle_offsets[vertex + 1] += triangle_offsets[vertex];
+        }
+        vertex_triangles.resize(current.size());
+        auto cursors = std::vector<std::uint32_t>(triangle_offsets.begin(), triangle_offsets.end() - 1);
+        for (auto i = std::size_t{0}; i < current.size(); ++i) {
+            vertex_triangles[cursors[current[i]]++] = static_cast<std::uint32_t>(i / 3);
+        }
+        const auto triangles_of = [&](const std::uint32_t vertex) {
+            return std::span{vertex_triangles}.subspan(triangle_offsets[vertex],
+                                                       triangle_offsets[vertex + 1] - triangle_offsets[vertex]);
+        };
+
+        is_touched.assign(vertices.size(), false);
+        for (auto vertex = std::uint32_t{0}; vertex < vertices.size(); ++vertex) {
+            remap[vertex] = vertex;
+        }
+        auto triangle_count = current.size() / 3;
+        const auto target_triangle_count = target_index_count / 3;
+        auto collapse_count = std::size_t{0};
+        for (const auto &collapse : collapses) {
+            if (triangle_count <= target_triangle_count) {
+                break;
+            }
+            if (is_touched[collapse.from] || is_touched[collapse.to] ||
+                flips_triangles(vertices, current, triangles_of(collapse.from), collapse)) {
+                continue;
+            }
+            const auto error = collapse_error(vertices, current, triangles_of(collapse.from), vertex_errors, collapse);
+            if (error > max_error) {
+                continue;
+            }
+
+            // the triangles around `from` change: none of their vertices may move again in this pass
+            for (const auto triangle : triangles_of(collapse.from)) {
+                const auto *const corners = &current[triangle * 3];
+                is_touched[corners[0]] = is_touched[corners[1]] = is_touched[corners[2]] = true;
+                if (corners[0] == collapse.to || corners[1] == collapse.to || corners[2] == collapse.to) {
+                    --triangle_count;
+                }
+            }
+            remap[collapse.from] = collapse.to;
+            vertex_errors[collapse.to] = error;
+            quadrics[collapse.to] += quadrics[collapse.from];
+            result.error = std::max(result.error, error);
+            ++collapse_count;
+        }
+        if (collapse_count == 0) {
+            break;
+        }
+
+        auto kept_index_count = std::size_t{0};
+        for (auto i = std::size_t{0}; i < current.size(); i += 3) {
+            const auto a = remap[current[i]];
+            const auto b = remap[current[i + 1]];
+            const auto c = remap[current[i + 2]];
+            if (a != b && b != c && c != a) {
+                current[kept_index_count++] = a;
+                current[kept_index_count++] = b;
+                current[kept_index_count++] = c;
+            }
+        }
+        current.resize(kept_index_count);
+    }
+
+    return result;
+}
+
+void generate_lods(mesh_data_s &mesh_data, const lod_generation_options_s &options) {
+    const auto source_lod = mesh_data.lods.empty()
+                                    ? mesh_lod_s{.index_count = static_cast<std::uint32_t>(mesh_data.indices.size())}
+                                    : mesh_data.lods.front();
+    auto indices = std::vector<std::uint32_t>{mesh_data.indices.begin() + source_lod.first_index,
+                                              mesh_data.indices.begin() + source_lod.first_index +
+                                                      source_lod.index_count};
+    const auto max_error = options.max_relative_error * compute_bounds(mesh_data.vertices).radius;
+
+    mesh_data.indices = indices;
+    mesh_data.lods = {mesh_lod_s{.first_index = 0, .index_count = source_lod.index_count, .error = 0.0f}};
+
+    auto error = 0.0f;
+    while (mesh_data.lods.size() < options.max_lod_count) {
+        const auto target_index_count = static_cast<std::size_t>(static_cast<float>(indices.size() / 3) *
+                                                                 options.reduction) * 3;
+        // the error left to spend: the deviations of consecutive levels add up at most
+        auto simplified = simplify(mesh_data.vertices, indices, target_index_count, max_error - error);
+        if (simplified.indices.empty() || simplified.indices.size() * 10 > indices.size() * 9) {
+            break;
+        }
+
+        error += simplified.error;
+        mesh_data.lods.push_back({.first_index = static_cast<std::uint32_t>(mesh_data.indices.size()),
+                                  .index_count = static_cast<std::uint32_t>(simplified.indices.size()),
+                                  .error = error});
+        mesh_data.indices.insert(mesh_data.indices.end(), simplified.indices.begin(), simplified.indices.end());
+        indices = std::move(simplified.indices);
+    }
+}
+
+} // namespace sm::arcane::primitive_graphics
@@ -0,0 +1,46 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "primitive_graphics/mesh_data.hpp"
+
+namespace sm::arcane::primitive_graphics {
+
+struct simplified_indices_s {
+    std::vector<std::uint32_t> indices;
+    // How far the simplified surface gets from the source one, at most: every collapse adds the distance of the removed
+    // vertex to the surface replacing it to how far that surface already was. Not the mean distance of the quadrics
+    // ordering the collapses, which understates the error where a level of detail is selected by it
+    float error = 0.0f;
+};
+
+// Quadric error metric simplification (Garland, Heckbert, "Surface Simplification Using Quadric Error Metrics", 1997)
+// restricted to collapsing edges onto one of their vertices, so the result indexes the same `vertices` and every level
+// of detail of a mesh shares one vertex range. Vertices on an open border, or at a seam (several vertices with one
+// position, e.g. across a hard edge), are never moved, and no collapse flips a triangle. Stops at
+// `target_index_count`, or earlier when no collapse within `max_error` is left
+[[nodiscard]] simplified_indices_s simplify(std::span<const vertex_s> vertices,
+                                           std::span<const std::uint32_t> indices,
+                                           std::size_t target_index_count,
+                                           float max_error);
+
+struct lod_generation_options_s {
+    // the levels including the source one
+    std::size_t max_lod_count = 6;
+    // the index count of a level relative to the previous one
+    float reduction = 0.5f;
+    // relative to the radius of the mesh's bounds: how far from the source any level may get
+    float max_relative_error = 0.1f;
+};
+
+// Replaces the levels of detail of `mesh_data` with a chain simplified from its finest one, each level from the
+// previous one; the chain ends early once a level is no longer noticeably smaller than the previous one
+void generate_lods(mesh_data_s &mesh_data, const lod_generation_options_s &options = {});
+
+} // namespace sm::arcane::primitive_graphics
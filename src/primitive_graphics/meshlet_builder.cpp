@@ -0,0 +1,234 @@
+#include "meshlet_builder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+namespace sm::arcane::primitive_graphics {
+
+namespace {
+
+// the triangles around each vertex, in CSR form
+struct vertex_triangles_s {
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> triangles;
+
+    [[nodiscard]] std::span<const std::uint32_t> of(const std::uint32_t vertex) const noexcept {
+        return std::span{triangles}.subspan(offsets[vertex], offsets[vertex + 1] - offsets[vertex]);
+    }
+};
+
+[[nodiscard]] vertex_triangles_s build_vertex_triangles(const std::span<const std::uint32_t> indices,
+                                                        const std::size_t vertex_count) {
+    auto adjacency = vertex_triangles_s{.offsets = std::vector<std::uint32_t>(vertex_count + 1, 0),
+                                        .triangles = std::vector<std::uint32_t>(indices.size())};
+    for (const auto index : indices) {
+        ++adjacency.offsets[index + 1];
+    }
+    for (auto vertex = std::size_t{0}; vertex < vertex_count; ++vertex) {
+        adjacency.offsets[vertex + 1] += adjacency.offsets[vertex];
+    }
+    auto cursors = std::vector<std::uint32_t>(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+    for (auto i = std::size_t{0}; i < indices.size(); ++i) {
+        adjacency.triangles[cursors[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+    }
+    return adjacency;
+}
+
+[[nodiscard]] std::int8_t to_snorm8(const float value) noexcept {
+    return static_cast<std::int8_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 127.0f));
+}
+
+[[nodiscard]] std::uint32_t pack_snorm8x4(const std::array<std::int8_t, 4> &values) noexcept {
+    auto packed = std::uint32_t{0};
+    for (auto i = std::size_t{0}; i < values.size(); ++i) {
+        packed |= std::uint32_t{static_cast<std::uint8_t>(values[i])} << (8 * i);
+    }
+    return packed;
+}
+
+// The normal cone is computed around the quantized axis, the one the shader tests with, and its sine is rounded up, so
+// the quantized cone still contains every normal
+[[nodiscard]] std::uint32_t compute_normal_cone(const std::span<const vertex_s> vertices,
+                                                const std::span<const std::uint32_t> indices) noexcept {
+    constexpr auto no_cone = std::array<std::int8_t, 4>{0, 0, 0, 127};
+
+    auto normal_sum = glm::f32vec3{0.0f};
+    for (auto i = std::size_t{0}; i < indices.size(); i += 3) {
+        const auto &p0 = vertices[indices[i]].position;
+        const auto normal = glm::cross(vertices[indices[i + 1]].position - p0, vertices[indices[i + 2]].position - p0);
+        if (const auto length = glm::length(normal); length > 0.0f) {
+            normal_sum += normal / length;
+        }
+    }
+    if (glm::length(normal_sum) == 0.0f) {
+        return pack_snorm8x4(no_cone);
+    }
+
+    const auto axis = glm::normalize(normal_sum);
+    const auto quantized = std::array{to_snorm8(axis.x), to_snorm8(axis.y), to_snorm8(axis.z)};
+    const auto quantized_axis = glm::normalize(glm::f32vec3{static_cast<float>(quantized[0]),
+                                                                static_cast<float>(quantized[1]),
+                                                                static_cast<float>(quantized[2])});
+
+    auto min_cosine = 1.0f;
+    for (auto i = std::size_t{0}; i < indices.size(); i += 3) {
+        const auto &p0 = vertices[indices[i]].position;
+        const auto normal = glm::cross(vertices[indices[i + 1]].position - p0, vertices[indices[i + 2]].position - p0);
+        if (const auto length = glm::length(normal); length > 0.0f) {
+            min_cosine = std::min(min_cosine, glm::dot(quantized_axis, normal / length));
+        }
+    }
+    // wider than about 84 degrees: no camera outside the sphere would see every triangle from behind
+    if (min_cosine <= 0.1f) {
+        return pack_snorm8x4(no_cone);
+    }
+
+    const auto sine = std::sqrt(1.0f - min_cosine * min_cosine);
+    const auto quantized_sine = static_cast<std::int8_t>(std::min(std::ceil(sine * 127.0f), 127.0f));
+    return pack_snorm8x4({quantized[0], quantized[1], quantized[2], quantized_sine});
+}
+
+[[nodiscard]] meshlet_s make_meshlet(const std::span<const vertex_s> vertices,
+                                     const std::span<const std::uint32_t> indices,
+                                     const std::span<const std::uint32_t> meshlet_vertices,
+                                     const std::uint32_t first_index) {
+    auto positions = std::vector<vertex_s>{};
+    positions.reserve(meshlet_vertices.size());
+    for (const auto vertex : meshlet_vertices) {
+        positions.push_back(vertices[vertex]);
+    }
+    const auto bounds = compute_bounds(positions);
+
+    return {.center = bounds.center,
+            .radius = bounds.radius,
+            .cone = compute_normal_cone(vertices, indices),
+            .first_index = first_index,
+            .index_count = static_cast<std::uint32_t>(indices.size()),
+            .vertex_count = static_cast<std::uint32_t>(meshlet_vertices.size())};
+}
+
+[[nodiscard]] glm::f32vec3 centroid(const std::span<const vertex_s> vertices,
+                                   const std::span<const std::uint32_t> indices,
+                                   const std::uint32_t triangle) noexcept {
+    return (vertices[indices[triangle * 3]].position + vertices[indices[triangle * 3 + 1]].position +
+            vertices[indices[triangle * 3 + 2]].position) /
+           3.0f;
+}
+
+// appends the meshlets of one level, whose indices start at `first_index` of the mesh, and reorders its triangles
+void append_meshlets(const std::span<const vertex_s> vertices,
+                     const std::span<std::uint32_t> indices,
+                     const std::uint32_t first_index,
+                     std::vector<meshlet_s> &meshlets) {
+    constexpr auto none = std::numeric_limits<std::uint32_t>::max();
+    const auto triangle_count = indices.size() / 3;
+    const auto adjacency = build_vertex_triangles(indices, vertices.size());
+
+    auto is_emitted = std::vector<bool>(triangle_count, false);
+    // the meshlet a vertex was last added to, so that membership is a single comparison
+    auto vertex_meshlets = std::vector<std::uint32_t>(vertices.size(), none);
+    auto meshlet_vertices = std::vector<std::uint32_t>{};
+    // the triangles sharing a vertex with the meshlet, possibly more than once
+    auto candidates = std::vector<std::uint32_t>{};
+    auto clustered = std::vector<std::uint32_t>{};
+    clustered.reserve(indices.size());
+
+    auto seed = std::size_t{0};
+    while (clustered.size() < indices.size()) {
+        const auto meshlet_index = static_cast<std::uint32_t>(meshlets.size());
+        const auto meshlet_first_index = clustered.size();
+        meshlet_vertices.clear();
+        candidates.clear();
+        auto centroid_sum = glm::f32vec3{0.0f};
+
+        while (is_emitted[seed]) {
+            ++seed;
+        }
+        auto triangle = static_cast<std::uint32_t>(seed);
+        while (triangle != none) {
+            is_emitted[triangle] = true;
+            centroid_sum += centroid(vertices, indices, triangle);
+            for (auto corner = std::size_t{0}; corner < 3; ++corner) {
+                const auto vertex = indices[triangle * 3 + corner];
+                clustered.push_back(vertex);
+                if (vertex_meshlets[vertex] != meshlet_index) {
+                    vertex_meshlets[vertex] = meshlet_index;
+                    meshlet_vertices.push_back(vertex);
+                    for (const auto adjacent : adjacency.of(vertex)) {
+                        if (!is_emitted[adjacent]) {
+                            candidates.push_back(adjacent);
+                        }
+                    }
+                }
+            }
+            const auto meshlet_triangle_count = (clustered.size() - meshlet_first_index) / 3;
+            if (meshlet_triangle_count == g_max_meshlet_triangle_count) {
+                break;
+            }
+
+            // the candidate adding the fewest vertices, then the closest one, which keeps the meshlet round and its
+            // bounds tight
+            std::erase_if(candidates, [&is_emitted](const std::uint32_t candidate) { return is_emitted[candidate]; });
+            const auto center = centroid_sum / static_cast<float>(meshlet_triangle_count);
+            triangle = none;
+            auto best_count = std::size_t{0};
+            auto best_distance = 0.0f;
+            for (const auto candidate : candidates) {
+                auto count = std::size_t{0};
+                for (auto corner = std::size_t{0}; corner < 3; ++corner) {
+                    count += vertex_meshlets[indices[candidate * 3 + corner]] != meshlet_index ? 1 : 0;
+                }
+                if (meshlet_vertices.size() + count > g_max_meshlet_vertex_count) {
+                    continue;
+                }
+                const auto offset = centroid(vertices, indices, candidate) - center;
+                const auto distance = glm::dot(offset, offset);
+                if (triangle == none || count < best_count || (count == best_count && distance < best_distance)) {
+                    triangle = candidate;
+                    best_count = count;
+                    best_distance = distance;
+                }
+            }
+        }
+
+        const auto meshlet_indices = std::span{clustered}.subspan(meshlet_first_index);
+        meshlets.push_back(make_meshlet(vertices,
+                                        meshlet_indices,
+                                        meshlet_vertices,
+                                        first_index + static_cast<std::uint32_t>(meshlet_first_index)));
+    }
+
+    std::ranges::copy(clustered, indices.begin());
+}
+
+} // namespace
+
+void build_meshlets(mesh_data_s &mesh_data) {
+    assert(mesh_data.indices.size() % 3 == 0);
+
+    if (mesh_data.lods.empty()) {
+        mesh_data.lods = {mesh_lod_s{.first_index = 0,
+                                     .index_count = static_cast<std::uint32_t>(mesh_data.indices.size())}};
+    }
+
+    mesh_data.meshlets.clear();
+    for (auto &lod : mesh_data.lods) {
+        lod.first_meshlet = static_cast<std::uint32_t>(mesh_data.meshlets.size());
+        append_meshlets(mesh_data.vertices,
+                        std::span{mesh_data.indices}.subspan(lod.first_index, lod.index_count),
+                        lod.first_index,
+                        mesh_data.meshlets);
+        lod.meshlet_count = static_cast<std::uint32_t>(mesh_data.meshlets.size()) - lod.first_meshlet;
+    }
+}
+
+} // namespace sm::arcane::primitive_graphics
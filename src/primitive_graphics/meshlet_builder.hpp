@@ -0,0 +1,22 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <cstddef>
+
+#include "primitive_graphics/mesh_data.hpp"
+
+namespace sm::arcane::primitive_graphics {
+
+// the limits `VK_EXT_mesh_shader` implementations are fastest with, which also keep the clusters small enough to cull
+inline constexpr auto g_max_meshlet_vertex_count = std::size_t{64};
+inline constexpr auto g_max_meshlet_triangle_count = std::size_t{124};
+
+// Splits every level of detail of `mesh_data` into meshlets: each is grown from a seed triangle by the adjacent
+// triangle adding the fewest vertices, until a limit is reached or no adjacent triangle is left. The triangles of a
+// level are reordered so that every meshlet is a contiguous range of its indices; a mesh without levels of detail gets
+// its single level listed
+void build_meshlets(mesh_data_s &mesh_data);
+
+} // namespace sm::arcane::primitive_graphics
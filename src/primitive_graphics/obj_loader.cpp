@@ -0,0 +1,149 @@
+#include "obj_loader.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glm/geometric.hpp>
+#include <tiny_obj_loader.h>
+
+namespace sm::arcane::primitive_graphics {
+
+namespace {
+
+[[nodiscard]] glm::f32vec3 read_vec3(const std::vector<tinyobj::real_t> &values, const int index) noexcept {
+    const auto i = static_cast<std::size_t>(index) * 3;
+    return {values[i], values[i + 1], values[i + 2]};
+}
+
+// the normal of the file, unless it has none or too short to have a direction (e.g. `vn 0 0 0`), which normalizing
+// would turn into NaN
+[[nodiscard]] std::optional<glm::f32vec3> read_normal(const tinyobj::attrib_t &attrib,
+                                                      const tinyobj::index_t &index) noexcept {
+    constexpr auto min_length = 1e-12f;
+    if (index.normal_index < 0) {
+        return std::nullopt;
+    }
+    const auto normal = read_vec3(attrib.normals, index.normal_index);
+    const auto length = glm::length(normal);
+    return length > min_length ? std::optional{normal / length} : std::nullopt;
+}
+
+[[nodiscard]] bool has_missing_normals(const tinyobj::attrib_t &attrib,
+                                       const std::vector<tinyobj::shape_t> &shapes) noexcept {
+    for (const auto &shape : shapes) {
+        for (const auto &index : shape.mesh.indices) {
+            if (!read_normal(attrib, index)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// one per position: the sum of the cross products of the faces around it is weighted by their areas already
+[[nodiscard]] std::vector<glm::f32vec3> generate_normals(const tinyobj::attrib_t &attrib,
+                                                        const std::vector<tinyobj::shape_t> &shapes) {
+    auto normals = std::vector<glm::f32vec3>(attrib.vertices.size() / 3, glm::f32vec3{0.0f});
+    for (const auto &shape : shapes) {
+        const auto &indices = shape.mesh.indices;
+        for (auto i = std::size_t{0}; i + 2 < indices.size(); i += 3) {
+            const auto p0 = read_vec3(attrib.vertices, indices[i].vertex_index);
+            const auto p1 = read_vec3(attrib.vertices, indices[i + 1].vertex_index);
+            const auto p2 = read_vec3(attrib.vertices, indices[i + 2].vertex_index);
+            const auto face_normal = glm::cross(p1 - p0, p2 - p0);
+            for (auto corner = std::size_t{0}; corner < 3; ++corner) {
+                normals[static_cast<std::size_t>(indices[i + corner].vertex_index)] += face_normal;
+            }
+        }
+    }
+
+    for (auto &normal : normals) {
+        const auto length = glm::length(normal);
+        normal = length > 0.0f ? normal / length : glm::f32vec3{0.0f, 0.0f, 1.0f};
+    }
+    return normals;
+}
+
+} // namespace
+
+mesh_data_s load_obj(const std::filesystem::path &path) {
+    auto reader_config = tinyobj::ObjReaderConfig{};
+    reader_config.triangulate = true;
+    reader_config.vertex_color = true;
+    // the MTL library is looked up next to the OBJ file
+    reader_config.mtl_search_path = path.parent_path().string();
+
+    auto reader = tinyobj::ObjReader{};
+    if (!reader.ParseFromFile(path.string(), reader_config)) {
+        throw std::runtime_error{"Failed to load the OBJ file " + path.string() + ": " + reader.Error()};
+    }
+
+    const auto &attrib = reader.GetAttrib();
+    const auto &shapes = reader.GetShapes();
+    const auto &materials = reader.GetMaterials();
+
+    const auto generated_normals = has_missing_normals(attrib, shapes) ? generate_normals(attrib, shapes)
+                                                                       : std::vector<glm::f32vec3>{};
+
+    auto index_count = std::size_t{0};
+    for (const auto &shape : shapes) {
+        index_count += shape.mesh.indices.size();
+    }
+
+    auto mesh_data = mesh_data_s{};
+    mesh_data.indices.reserve(index_count);
+    // most vertices of a closed mesh are shared by about six triangles
+    mesh_data.vertices.reserve(index_count / 6 + 3);
+    auto vertex_indices = std::unordered_map<vertex_s, std::uint32_t, vertex_hash_s>{};
+    vertex_indices.reserve(index_count / 6 + 3);
+
+    for (const auto &shape : shapes) {
+        const auto &indices = shape.mesh.indices;
+        for (auto i = std::size_t{0}; i < indices.size(); ++i) {
+            const auto &index = indices[i];
+
+            auto color = glm::f32vec4{1.0f};
+            // tinyobjloader fills in white for the vertices without a color, unless none of them has one
+            if (attrib.colors.size() == attrib.vertices.size()) {
+                color = glm::f32vec4{read_vec3(attrib.colors, index.vertex_index), 1.0f};
+            }
+            if (const auto material_id = shape.mesh.material_ids[i / 3];
+                material_id >= 0 && static_cast<std::size_t>(material_id) < materials.size()) {
+                const auto &material = materials[static_cast<std::size_t>(material_id)];
+                color *= glm::f32vec4{material.diffuse[0], material.diffuse[1], material.diffuse[2], material.dissolve};
+            }
+
+            // the generated normals are only there if some normal of the file is unusable
+            const auto normal = read_normal(attrib, index);
+            const auto vertex = vertex_s{
+                    .position = read_vec3(attrib.vertices, index.vertex_index),
+                    .color = color,
+                    .normal = normal ? *normal : generated_normals[static_cast<std::size_t>(index.vertex_index)]};
+
+            const auto [it, is_new] = vertex_indices.try_emplace(
+                    vertex,
+                    static_cast<std::uint32_t>(mesh_data.vertices.size()));
+            if (is_new) {
+                mesh_data.vertices.push_back(vertex);
+            }
+            mesh_data.indices.push_back(it->second);
+        }
+    }
+
+    if (mesh_data.vertices.empty()) {
+        throw std::runtime_error{"The OBJ file " + path.string() + " has no faces"};
+    }
+    return mesh_data;
+}
+
+std::future<mesh_data_s> load_obj_async(util::ThreadPool &thread_pool, std::filesystem::path path) {
+    return thread_pool.submit([path = std::move(path)] { return load_obj(path); });
+}
+
+} // namespace sm::arcane::primitive_graphics
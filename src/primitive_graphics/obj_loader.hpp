@@ -0,0 +1,25 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <filesystem>
+#include <future>
+
+#include "primitive_graphics/mesh_data.hpp"
+#include "util/thread_pool.hpp"
+
+namespace sm::arcane::primitive_graphics {
+
+// Parses a Wavefront OBJ file (and its MTL library, if any) into a single indexed triangle list: every shape is
+// merged, faces are triangulated, identical vertices are shared. The color of a vertex is its OBJ vertex color times
+// the diffuse color of its face's material; normals missing from the file, or too short to have a direction, are
+// generated by averaging the area-weighted normals of the faces around each position. Throws
+// `std::runtime_error` when the file can't be parsed
+[[nodiscard]] mesh_data_s load_obj(const std::filesystem::path &path);
+
+// `load_obj` on a worker of `thread_pool`, so that large models don't stall the render loop. The result is only CPU
+// data: the `Mesh` is then created on the render thread, which owns the upload service
+[[nodiscard]] std::future<mesh_data_s> load_obj_async(util::ThreadPool &thread_pool, std::filesystem::path path);
+
+} // namespace sm::arcane::primitive_graphics
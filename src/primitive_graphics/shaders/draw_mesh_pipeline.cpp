@@ -1 +1,23 @@
-#include "draw_mesh_pipeline.hpp"
\ No newline at end of file
+#include "draw_mesh_pipeline.hpp"
+
+#include <utility>
+
+#include "primitive_graphics/vertex_format.hpp"
+
+namespace sm::arcane::primitive_graphics::shaders {
+
+vulkan::graphics_pipeline_desc_s draw_mesh_pipeline_desc(const vk::PipelineLayout pipeline_layout,
+                                                         const vk::Format color_format,
+                                                         const vk::Format depth_format) {
+    // the normals are there too, the shader just doesn't read them
+    auto vertex_input = vertex_input(vertex_format_e::full);
+    return {.vertex_shader = "draw_mesh.vert",
+            .fragment_shader = "draw_mesh.frag",
+            .layout = pipeline_layout,
+            .vertex_bindings = std::move(vertex_input.bindings),
+            .vertex_attributes = std::move(vertex_input.attributes),
+            .color_formats = {color_format},
+            .depth_format = depth_format};
+}
+
+} // namespace sm::arcane::primitive_graphics::shaders
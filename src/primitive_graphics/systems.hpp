@@ -3,8 +3,6 @@
 
 #pragma once
 
-#include <utility>
-
 #include "primitive_graphics/mesh.hpp"
 #include "primitive_graphics/shaders/draw_mesh_pipeline.hpp"
 #include "render/common.hpp"
@@ -15,35 +13,23 @@ namespace sm::arcane::primitive_graphics {
 class DrawMeshSystem {
 public:
     struct resources_s {
-        shaders::DynamicDrawMeshPipeline draw_mesh_pipeline;
+        vulkan::pipeline_t draw_mesh_pipeline;
 
         Mesh cube_mesh;
 
         [[nodiscard]] static resources_s create(const render::pass_context_s &ctx) {
-            auto vertices = blanks::cube_vertices;
-            auto indices = blanks::cube_indices;
-
-            return {.draw_mesh_pipeline = {ctx.device.device(),
-                                           ctx.global.descriptor_set_layout,
-                                           ctx.swapchain->color_format(),
-                                           ctx.swapchain->depth_format()},
-                    .cube_mesh = Mesh{ctx.device,
-                                      *ctx.swapchain->command_pool(),
-                                      std::move(vertices),
-                                      std::move(indices)}};
+            return {.draw_mesh_pipeline = ctx.pipeline_registry.register_pipeline(
+                            shaders::draw_mesh_pipeline_desc(ctx.global.pipeline_layout,
+                                                             ctx.swapchain->color_format(),
+                                                             ctx.swapchain->depth_format())),
+                    .cube_mesh = Mesh{ctx.geometry_pool, blanks::cube_vertices, blanks::cube_indices}};
         }
     };
 
     explicit DrawMeshSystem(const render::pass_context_s &ctx) : m_resources{resources_s::create(ctx)} {}
 
     void render(const render::render_args_s &args) const {
-        args.command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, *m_resources.draw_mesh_pipeline.handle());
-
-        args.command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-                                               *m_resources.draw_mesh_pipeline.layout(),
-                                               0,
-                                               {args.global.descriptor_set},
-                                               nullptr);
+        args.command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, **m_resources.draw_mesh_pipeline);
 
         m_resources.cube_mesh.bind(args.command_buffer);
         m_resources.cube_mesh.draw(args.command_buffer);
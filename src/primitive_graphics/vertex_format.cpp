@@ -0,0 +1,141 @@
+#include "vertex_format.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace sm::arcane::primitive_graphics {
+
+namespace {
+
+[[nodiscard]] std::int16_t to_snorm16(const float value) noexcept {
+    return static_cast<std::int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+[[nodiscard]] std::uint8_t to_unorm8(const float value) noexcept {
+    return static_cast<std::uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+}
+
+// the unit sphere projected onto an octahedron, then the octahedron unfolded onto the [-1, 1] square; decoded by
+// `decode_octahedral` in `vertex_encoding.glsl`
+[[nodiscard]] glm::f32vec2 encode_octahedral(const glm::f32vec3 &normal) noexcept {
+    const auto l1_norm = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    if (l1_norm == 0.0f) {
+        return glm::f32vec2{0.0f};
+    }
+
+    const auto n = normal / l1_norm;
+    if (n.z >= 0.0f) {
+        return {n.x, n.y};
+    }
+    return {(1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+            (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f)};
+}
+
+} // namespace
+
+vertex_input_s vertex_input(const vertex_format_e vertex_format) {
+    if (vertex_format == vertex_format_e::full) {
+        return {.bindings = {vk::VertexInputBindingDescription{0, sizeof(vertex_s), vk::VertexInputRate::eVertex}},
+                .attributes = {vk::VertexInputAttributeDescription{0,
+                                                                   0,
+                                                                   vk::Format::eR32G32B32Sfloat,
+                                                                   offsetof(vertex_s, position)},
+                               vk::VertexInputAttributeDescription{1,
+                                                                   0,
+                                                                   vk::Format::eR32G32B32A32Sfloat,
+                                                                   offsetof(vertex_s, color)},
+                               vk::VertexInputAttributeDescription{2,
+                                                                   0,
+                                                                   vk::Format::eR32G32B32Sfloat,
+                                                                   offsetof(vertex_s, normal)}}};
+    }
+
+    return {.bindings = {vk::VertexInputBindingDescription{0,
+                                                           sizeof(compact_vertex_s),
+                                                           vk::VertexInputRate::eVertex}},
+            .attributes = {vk::VertexInputAttributeDescription{0,
+                                                               0,
+                                                               vk::Format::eR16G16B16A16Snorm,
+                                                               offsetof(compact_vertex_s, position)},
+                           vk::VertexInputAttributeDescription{1,
+                                                               0,
+                                                               vk::Format::eR8G8B8A8Unorm,
+                                                               offsetof(compact_vertex_s, color)},
+                           vk::VertexInputAttributeDescription{2,
+                                                               0,
+                                                               vk::Format::eR16G16Snorm,
+                                                               offsetof(compact_vertex_s, normal)}}};
+}
+
+std::uint32_t vertex_stride(const vertex_format_e vertex_format) noexcept {
+    return vertex_format == vertex_format_e::full ? sizeof(vertex_s) : sizeof(compact_vertex_s);
+}
+
+aabb_s compute_aabb(const std::span<const vertex_s> vertices) noexcept {
+    if (vertices.empty()) {
+        return {};
+    }
+
+    auto aabb = aabb_s{.min = vertices.front().position, .max = vertices.front().position};
+    for (const auto &vertex : vertices) {
+        aabb.min = glm::min(aabb.min, vertex.position);
+        aabb.max = glm::max(aabb.max, vertex.position);
+    }
+    return aabb;
+}
+
+bounding_sphere_s compute_bounds(const std::span<const vertex_s> vertices) noexcept {
+    const auto aabb = compute_aabb(vertices);
+    auto bounds = bounding_sphere_s{.center = (aabb.min + aabb.max) * 0.5f, .radius = 0.0f};
+    for (const auto &vertex : vertices) {
+        bounds.radius = std::max(bounds.radius, glm::distance(bounds.center, vertex.position));
+    }
+    return bounds;
+}
+
+glm::f32mat4 compute_vertex_transform(const aabb_s &aabb, const vertex_format_e vertex_format) noexcept {
+    if (vertex_format == vertex_format_e::full) {
+        return glm::f32mat4{1.0f};
+    }
+
+    const auto half_extent = (aabb.max - aabb.min) * 0.5f;
+    auto scale = std::max({half_extent.x, half_extent.y, half_extent.z});
+    // a degenerate mesh still needs an invertible transform
+    if (scale == 0.0f) {
+        scale = 1.0f;
+    }
+    return glm::scale(glm::translate(glm::f32mat4{1.0f}, (aabb.min + aabb.max) * 0.5f), glm::f32vec3{scale});
+}
+
+bounding_sphere_s to_vertex_space(const bounding_sphere_s &bounds, const glm::f32mat4 &vertex_transform) noexcept {
+    const auto scale = vertex_transform[0][0];
+    return {.center = (bounds.center - glm::f32vec3{vertex_transform[3]}) / scale, .radius = bounds.radius / scale};
+}
+
+std::vector<compact_vertex_s> to_compact_vertices(const std::span<const vertex_s> vertices,
+                                                  const glm::f32mat4 &vertex_transform) {
+    const auto offset = glm::f32vec3{vertex_transform[3]};
+    const auto scale = vertex_transform[0][0];
+
+    auto compact_vertices = std::vector<compact_vertex_s>{};
+    compact_vertices.reserve(vertices.size());
+    for (const auto &vertex : vertices) {
+        const auto position = (vertex.position - offset) / scale;
+        const auto normal = encode_octahedral(vertex.normal);
+        compact_vertices.push_back(
+                {.position = {to_snorm16(position.x), to_snorm16(position.y), to_snorm16(position.z), 0},
+                 .normal = {to_snorm16(normal.x), to_snorm16(normal.y)},
+                 .color = {to_unorm8(vertex.color.r),
+                           to_unorm8(vertex.color.g),
+                           to_unorm8(vertex.color.b),
+                           to_unorm8(vertex.color.a)}});
+    }
+    return compact_vertices;
+}
+
+} // namespace sm::arcane::primitive_graphics
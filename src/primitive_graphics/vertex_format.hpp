@@ -0,0 +1,81 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/fwd.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace sm::arcane::primitive_graphics {
+
+struct vertex_s {
+    glm::f32vec3 position;
+    glm::f32vec4 color;
+    glm::f32vec3 normal;
+
+    [[nodiscard]] bool operator==(const vertex_s &other) const noexcept = default;
+};
+
+// `vertex_s` quantized. The position is snorm16 in a cube around the mesh's bounds, mapped back to the local space of
+// the mesh by its vertex transform (see `compute_vertex_transform`); the scale is uniform, so bounding spheres stay
+// spheres. The normal is octahedral-encoded into two snorm16, the color is RGBA8 unorm. Same attribute locations as
+// `vertex_s`
+struct compact_vertex_s {
+    std::array<std::int16_t, 4> position;
+    std::array<std::int16_t, 2> normal;
+    std::array<std::uint8_t, 4> color;
+};
+static_assert(sizeof(compact_vertex_s) == 16);
+
+enum class vertex_format_e {
+    // `vertex_s` as is, 40 bytes
+    full,
+    // `compact_vertex_s`, 16 bytes: for dense meshes, where vertex fetch bandwidth is what matters
+    compact
+};
+
+// the vertex input state of the pipelines drawing a given vertex format
+struct vertex_input_s {
+    std::vector<vk::VertexInputBindingDescription> bindings;
+    std::vector<vk::VertexInputAttributeDescription> attributes;
+};
+
+// in the local space of a mesh
+struct aabb_s {
+    glm::f32vec3 min{0.0f};
+    glm::f32vec3 max{0.0f};
+};
+
+// in the local space of a mesh
+struct bounding_sphere_s {
+    glm::f32vec3 center{0.0f};
+    float radius = 0.0f;
+};
+
+[[nodiscard]] vertex_input_s vertex_input(vertex_format_e vertex_format);
+[[nodiscard]] std::uint32_t vertex_stride(vertex_format_e vertex_format) noexcept;
+
+[[nodiscard]] aabb_s compute_aabb(std::span<const vertex_s> vertices) noexcept;
+// centered on the bounding box: not the tightest sphere, but never worse than the box's own bounding sphere
+[[nodiscard]] bounding_sphere_s compute_bounds(std::span<const vertex_s> vertices) noexcept;
+
+// Maps the vertex positions as stored in a given format to the local space of the mesh: identity unless compact,
+// otherwise the cube of the snorm16 positions onto the bounding box, centered on it and scaled by its largest
+// half-extent
+[[nodiscard]] glm::f32mat4 compute_vertex_transform(const aabb_s &aabb, vertex_format_e vertex_format) noexcept;
+// `bounds` in the space of the stored positions, i.e. before `vertex_transform`
+[[nodiscard]] bounding_sphere_s to_vertex_space(const bounding_sphere_s &bounds,
+                                                const glm::f32mat4 &vertex_transform) noexcept;
+
+[[nodiscard]] std::vector<compact_vertex_s> to_compact_vertices(std::span<const vertex_s> vertices,
+                                                                const glm::f32mat4 &vertex_transform);
+
+} // namespace sm::arcane::primitive_graphics
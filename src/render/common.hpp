@@ -3,25 +3,67 @@
 
 #pragma once
 
+#include <cstdint>
+
+#include "cameras/frustum.hpp"
+#include "cameras/lod_view.hpp"
+#include "scene/entity_registry.hpp"
+#include "util/thread_pool.hpp"
+#include "vulkan/bindless_heap.hpp"
+#include "vulkan/descriptor_cache.hpp"
+#include "vulkan/frame_allocator.hpp"
+#include "vulkan/geometry_pool.hpp"
+#include "vulkan/pipeline_registry.hpp"
 #include "vulkan/swapchain.hpp"
+#include "vulkan/upload_service.hpp"
 
 namespace sm::arcane::render {
 
+// the push constant range of the shared pipeline layout: the guaranteed minimum size, visible to every stage in use
+inline constexpr auto g_push_constants_stages = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment |
+                                                vk::ShaderStageFlagBits::eCompute;
+inline constexpr auto g_push_constants_size = std::uint32_t{128};
+
 struct global_render_args {
+    // shared by every pipeline: set 0 is the global set, set 1 is the bindless heap
+    vk::PipelineLayout pipeline_layout = nullptr;
     vk::DescriptorSetLayout descriptor_set_layout = nullptr;
     vk::DescriptorSet descriptor_set = nullptr;
+    vk::DescriptorSet bindless_descriptor_set = nullptr;
+    // the frame allocator buffer as a bindless storage buffer: per-frame arrays (e.g. instance data) are read from it
+    vulkan::bindless_id_t frame_allocator_buffer_id = vulkan::g_invalid_bindless_id;
+    // the offset of this frame's global UBO inside the frame allocator, bound as the set's dynamic offset
+    std::uint32_t dynamic_offset = 0;
 };
 
 struct render_args_s {
     vulkan::Device &device;
     const std::unique_ptr<vulkan::Swapchain> &swapchain;
     const vk::raii::CommandBuffer &command_buffer;
+    vulkan::FrameAllocator &frame_allocator;
+    // for the work of the frame worth splitting across threads, e.g. culling on the CPU
+    util::ThreadPool &thread_pool;
+    const vulkan::GeometryPool &geometry_pool;
+    // what is drawn, with its world transforms up to date
+    const scene::EntityRegistry &entities;
+    // The position of the camera of the frame. Everything handed to the GPU is relative to it: the world positions
+    // stay in double precision on the CPU, only their offsets from the camera are narrowed to floats, which keeps the
+    // precision of what is near the camera whatever its distance from the world origin
+    glm::f64vec3 origin{0.0};
+    // of the camera of the frame, relative to `origin`
+    cameras::frustum_s frustum;
+    cameras::lod_view_s lod_view;
     global_render_args global;
 };
 
 struct pass_context_s {
-    const vulkan::Device &device;
+    vulkan::Device &device;
     const std::unique_ptr<vulkan::Swapchain> &swapchain;
+    vulkan::UploadService &upload_service;
+    vulkan::GeometryPool &geometry_pool;
+    vulkan::DescriptorCache &descriptor_cache;
+    vulkan::BindlessHeap &bindless_heap;
+    vulkan::PipelineRegistry &pipeline_registry;
     global_render_args global;
 };
 
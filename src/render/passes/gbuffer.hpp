@@ -20,15 +20,31 @@ public:
           m_frame_info{frame_info},
           m_draw_game_object_system{pass_context} {}
 
-    void render(const render_args_s &args) const {
+    void render(const render_args_s &args) {
+        // compute work can't be recorded inside the rendering scope
+        bind_global_descriptor_sets(args, vk::PipelineBindPoint::eCompute);
+        m_draw_game_object_system.cull(args);
+
         begin(args.command_buffer);
         {
+            bind_global_descriptor_sets(args, vk::PipelineBindPoint::eGraphics);
+
             m_draw_game_object_system.render(args); //
         }
         end(args.command_buffer);
     }
 
 private:
+    // every pipeline is created with `global.pipeline_layout`, so the sets stay bound across the pipeline binds of
+    // the systems and are bound once per bind point for the whole pass
+    static void bind_global_descriptor_sets(const render_args_s &args, const vk::PipelineBindPoint bind_point) {
+        args.command_buffer.bindDescriptorSets(bind_point,
+                                               args.global.pipeline_layout,
+                                               0,
+                                               {args.global.descriptor_set, args.global.bindless_descriptor_set},
+                                               {args.global.dynamic_offset});
+    }
+
     void begin(const vk::raii::CommandBuffer &command_buffer) const {
         constexpr auto clear_values = std::array<vk::ClearValue, 2>{
                 vk::ClearColorValue{std::array{0.2f, 0.2f, 0.2f, 0.2f}},
@@ -1,14 +1,15 @@
 #include "renderer.hpp"
 
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstddef>
-#include <limits>
-#include <numeric>
 #include <stdexcept>
-#include <tuple>
 #include <utility>
 
+#include <glm/matrix.hpp>
+
 #include "render/common.hpp"
 #include "render/passes/common.hpp"
 
@@ -16,115 +17,67 @@ namespace sm::arcane {
 
 namespace {
 
-vk::raii::DescriptorSetLayout make_descriptor_set_layout(
-        const vk::raii::Device &device,
-        const std::vector<std::tuple<vk::DescriptorType, std::uint32_t, const vk::ShaderStageFlags>> &binding_data,
-        vk::DescriptorSetLayoutCreateFlags flags = {}) {
-    auto bindings = std::vector<vk::DescriptorSetLayoutBinding>(binding_data.size());
-    for (auto i = std::size_t{0}; i < binding_data.size(); ++i) {
-        bindings[i] = vk::DescriptorSetLayoutBinding(static_cast<std::uint32_t>(i),
-                                                     std::get<0>(binding_data[i]),
-                                                     std::get<1>(binding_data[i]),
-                                                     std::get<2>(binding_data[i]));
-    }
-    return {device, {flags, bindings}};
-}
-
-void update_descriptor_sets(
-        const vk::raii::Device &device,
-        const vk::raii::DescriptorSet &descriptor_set,
-        const std::vector<
-                std::tuple<vk::DescriptorType, const vk::raii::Buffer &, vk::DeviceSize, const vk::raii::BufferView *>>
-                &buffer_data,
-        std::nullptr_t,
-        const std::uint32_t binding_offset = 0) {
-    std::vector<vk::DescriptorBufferInfo> bufferInfos;
-    bufferInfos.reserve(buffer_data.size());
-
-    std::vector<vk::WriteDescriptorSet> writeDescriptorSets;
-    writeDescriptorSets.reserve(buffer_data.size());
-    std::uint32_t dstBinding = binding_offset;
-    for (auto const &bd : buffer_data) {
-        bufferInfos.emplace_back(std::get<1>(bd), 0, std::get<2>(bd));
-        vk::BufferView bufferView;
-        if (std::get<3>(bd)) {
-            bufferView = *std::get<3>(bd);
-        }
-        writeDescriptorSets.emplace_back(descriptor_set,
-                                         dstBinding++,
-                                         0,
-                                         1,
-                                         std::get<0>(bd),
-                                         nullptr,
-                                         &bufferInfos.back(),
-                                         std::get<3>(bd) ? &bufferView : nullptr);
-    }
-
-    device.updateDescriptorSets(writeDescriptorSets, nullptr);
-}
-
 struct global_ubo_s {
     glm::f32mat4 projection{1.0f};
     glm::f32mat4 view{1.0f};
     glm::f32mat4 inverseView{1.0f};
     glm::f32vec4 ambient_light_color{1.0f, 1.0f, 1.0f, 0.10f};
     glm::f32vec4 light_color{1.0};
+    // relative to the camera once uploaded, like every other position
     glm::f32vec3 light_position{0.0f, 0.0f, -1.0f};
 };
 
-[[nodiscard]] std::vector<vulkan::DeviceMemoryBuffer> create_global_ubos(
-        const vk::raii::PhysicalDevice &physical_device,
-        const vk::raii::Device &device) {
-    auto global_ubos = std::vector<vulkan::DeviceMemoryBuffer>{};
-    global_ubos.reserve(g_max_frames_in_flight);
-    for (auto i = std::size_t{0}; i < g_max_frames_in_flight; ++i) {
-        global_ubos.emplace_back(vulkan::DeviceMemoryBuffer{physical_device,
-                                                            device,
-                                                            vk::BufferUsageFlagBits::eUniformBuffer,
-                                                            sizeof(global_ubo_s)});
-    }
-    return global_ubos;
-}
-
-[[nodiscard]] vk::raii::DescriptorPool make_descriptor_pool(const vk::raii::Device &device,
-                                                            const std::vector<vk::DescriptorPoolSize> &pool_sizes) {
-    assert(!pool_sizes.empty());
-    const auto max_sets = static_cast<std::uint32_t>(std::accumulate(
-            pool_sizes.begin(),
-            pool_sizes.end(),
-            0,
-            [](const std::uint32_t sum, const vk::DescriptorPoolSize &dps) { return sum + dps.descriptorCount; }));
-    assert(0 < max_sets);
-    return {device,
-            vk::DescriptorPoolCreateInfo{vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet, max_sets, pool_sizes}};
+[[nodiscard]] global_resources_s create_render_resources(const vulkan::Device &device,
+                                                         vulkan::DescriptorCache &descriptor_cache,
+                                                         const vulkan::FrameAllocator &frame_allocator,
+                                                         vulkan::BindlessHeap &bindless_heap) {
+    static constexpr auto global_bindings = std::array{
+            vk::DescriptorSetLayoutBinding{0,
+                                           vk::DescriptorType::eUniformBufferDynamic,
+                                           1,
+                                           vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment}};
+    const auto global_descriptor_set_layout = descriptor_cache.layout(global_bindings);
+
+    // the global UBO lives in the frame allocator: the set is written once against its buffer and each frame binds
+    // it with the dynamic offset of that frame's `global_ubo_s`
+    const auto global_descriptor_set = descriptor_cache.create_set(
+            global_descriptor_set_layout,
+            [buffer = frame_allocator.buffer()](vulkan::DescriptorWriter &writer) {
+                writer.write_buffer(0, vk::DescriptorType::eUniformBufferDynamic, buffer, 0, sizeof(global_ubo_s));
+            });
+
+    const auto set_layouts = std::array{global_descriptor_set_layout, bindless_heap.layout()};
+    const auto push_constant_range = vk::PushConstantRange{render::g_push_constants_stages,
+                                                           0,
+                                                           render::g_push_constants_size};
+
+    return {.global_descriptor_set_layout = global_descriptor_set_layout,
+            .global_descriptor_set = global_descriptor_set,
+            .frame_allocator_buffer_id = bindless_heap.register_storage_buffer(frame_allocator.buffer()),
+            .pipeline_layout = {device.device(),
+                                vk::PipelineLayoutCreateInfo{{}, set_layouts, push_constant_range}}};
 }
 
-[[nodiscard]] global_resources_s create_render_resources(const vulkan::Device &device,
-                                                         const vk::CommandPool command_pool) {
-    auto global_descriptor_pool = make_descriptor_pool(device.device(),
-                                                       {{vk::DescriptorType::eUniformBuffer, g_max_frames_in_flight}});
-
-    auto global_descriptor_set_layout = make_descriptor_set_layout(
-            device.device(),
-            {{vk::DescriptorType::eUniformBuffer,
-              1,
-              vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment}});
-
-    const auto layouts = std::vector<vk::DescriptorSetLayout>{g_max_frames_in_flight, *global_descriptor_set_layout};
-    const auto global_desc_set_alloc_info = vk::DescriptorSetAllocateInfo{*global_descriptor_pool,
-                                                                          static_cast<std::uint32_t>(layouts.size()),
-                                                                          layouts.data()};
-    auto global_descriptor_sets = device.device().allocateDescriptorSets(global_desc_set_alloc_info);
-
-    auto global_ubos = create_global_ubos(device.physical_device(), device.device());
-
-    auto vertices = primitive_graphics::blanks::cube_vertices;
-    auto indices = primitive_graphics::blanks::cube_indices;
-
-    return {.global_descriptor_pool = std::move(global_descriptor_pool),
-            .global_ubos = std::move(global_ubos),
-            .global_descriptor_set_layout = std::move(global_descriptor_set_layout),
-            .global_descriptor_sets = std::move(global_descriptor_sets)};
+template<typename FrameResources>
+[[nodiscard]] std::vector<FrameResources> create_frame_resources(const vulkan::Device &device,
+                                                                 const std::uint32_t frames_in_flight) {
+    auto frames = std::vector<FrameResources>(frames_in_flight);
+    for (auto &frame : frames) {
+        // a transient pool per frame slot is reset as a whole instead of resetting individual command buffers
+        frame.command_pool = vk::raii::CommandPool{
+                device.device(),
+                vk::CommandPoolCreateInfo{vk::CommandPoolCreateFlagBits::eTransient,
+                                          device.queue_families().graphics.index}};
+        frame.command_buffer = std::move(
+                vk::raii::CommandBuffers{device.device(),
+                                         vk::CommandBufferAllocateInfo{*frame.command_pool,
+                                                                       vk::CommandBufferLevel::ePrimary,
+                                                                       1}}
+                        .front());
+
+        frame.semaphores.image_available = device.device().createSemaphore(vk::SemaphoreCreateInfo{});
+    }
+    return frames;
 }
 
 [[nodiscard]] render::passes::gpu_resources_s create_gpu_resources_for_frame(const vulkan::Device &device,
@@ -253,54 +206,117 @@ struct global_ubo_s {
 
 Renderer::Renderer(vulkan::Device &device,
                    std::unique_ptr<vulkan::Swapchain> &swapchain,
+                   const std::uint32_t frames_in_flight,
+                   util::ThreadPool &thread_pool,
                    std::shared_ptr<spdlog::logger> renderer_logger)
     : m_logger{std::move(renderer_logger)},
       m_device{device},
       m_swapchain{std::move(swapchain)},
-      m_resources{create_render_resources(m_device, m_swapchain->command_pool())},
+      m_thread_pool{thread_pool},
+      m_frames_in_flight{std::clamp(frames_in_flight, 1u, g_max_frames_in_flight)},
+      m_frame_allocator{m_device, m_frames_in_flight},
+      m_descriptor_cache{m_device.device()},
+      m_bindless_heap{m_device},
+      m_resources{create_render_resources(m_device, m_descriptor_cache, m_frame_allocator, m_bindless_heap)},
       m_current_frame_info{m_device.frame_info()},
-      m_frame_syncs{[&] {
-          auto frame_syncs = std::array<Renderer::frame_sync_s, g_max_frames_in_flight>{};
-          for (auto &sync : frame_syncs) {
-              sync.semaphores.image_available = m_device.device().createSemaphore({vk::SemaphoreCreateInfo{}});
-              sync.semaphores.render_finished = m_device.device().createSemaphore({vk::SemaphoreCreateInfo{}});
-              sync.fences.in_flight = vk::raii::Fence{m_device.device(), vk::FenceCreateInfo{}};
-          }
-          return frame_syncs;
-      }()},
-      m_gbuffer{{device, m_swapchain, m_resources.global_descriptor_set_layout}, m_current_frame_info} {}
+      m_frames{create_frame_resources<frame_resources_s>(m_device, m_frames_in_flight)},
+      m_upload_service{m_device},
+      m_geometry_pool{m_device, m_upload_service, m_bindless_heap},
+      m_pipeline_registry{m_device, thread_pool},
+      m_gbuffer{{device,
+                 m_swapchain,
+                 m_upload_service,
+                 m_geometry_pool,
+                 m_descriptor_cache,
+                 m_bindless_heap,
+                 m_pipeline_registry,
+                 {.pipeline_layout = *m_resources.pipeline_layout,
+                  .descriptor_set_layout = m_resources.global_descriptor_set_layout,
+                  .frame_allocator_buffer_id = m_resources.frame_allocator_buffer_id}},
+                m_current_frame_info} {
+    m_logger->info("Frames in flight: {}", m_frames_in_flight);
+
+    const auto compile_started_time = std::chrono::steady_clock::now();
+    const auto compiled_count = m_pipeline_registry.compile();
+    m_logger->info("Compiled {} pipelines on {} threads in {} ms (pipeline cache: {})",
+                   compiled_count,
+                   thread_pool.thread_count() + 1,
+                   std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+                                                                         compile_started_time)
+                           .count(),
+                   m_device.pipeline_cache().is_warm() ? "warm" : "cold");
+}
 
-void Renderer::begin_frame() {
-    m_swapchain->acquire_next_image(*m_frame_syncs[m_current_frame_info.frame_index].semaphores.image_available);
-    m_current_frame_info.started_time = std::chrono::steady_clock::now();
-    m_swapchain->command_buffers()[m_current_frame_info.image_index].begin(vk::CommandBufferBeginInfo{});
+void Renderer::on_swapchain_recreated() {
+    // the sets referring to swapchain-sized resources are re-written; nothing else is touched per frame
+    m_descriptor_cache.refresh();
 }
 
-void Renderer::end_frame() {
-    auto &frame_sync = m_frame_syncs[m_current_frame_info.frame_index];
-    const auto &command_buffer = m_swapchain->command_buffers()[m_current_frame_info.image_index];
+void Renderer::revalue_render_finished_semaphores() {
+    const auto image_count = m_swapchain->color_images().size();
+    if (m_render_finished_semaphores.size() == image_count) {
+        return;
+    }
+
+    // happens only after the swapchain has been recreated with a different image count, so the stall is affordable
+    m_device.device().waitIdle();
+
+    m_render_finished_semaphores.clear();
+    m_render_finished_semaphores.reserve(image_count);
+    for (auto i = std::size_t{0}; i < image_count; ++i) {
+        m_render_finished_semaphores.emplace_back(m_device.device(), vk::SemaphoreCreateInfo{});
+    }
+}
 
-    command_buffer.end();
+void Renderer::begin_frame() {
+    auto &frame = m_frames[m_current_frame_info.frame_index];
 
-    constexpr auto wait_stages = vk::PipelineStageFlags{vk::PipelineStageFlagBits::eColorAttachmentOutput};
+    // wait until the GPU has retired the previous submission of this slot; the other slots keep executing meanwhile
+    m_device.frame_scheduler().begin_frame(m_frames_in_flight);
+    m_frame_allocator.begin_frame(m_current_frame_info.frame_index);
 
-    const auto submit_info = vk::SubmitInfo{
-            *frame_sync.semaphores.image_available, // Wait semaphore
-            wait_stages, // Wait stages
-            *command_buffer, // Command buffer
-            *frame_sync.semaphores.render_finished // Signal semaphore
-    };
+    m_swapchain->acquire_next_image(*frame.semaphores.image_available);
+    revalue_render_finished_semaphores();
 
-    m_device.queue_families().graphics.queue.submit(submit_info, *frame_sync.fences.in_flight);
+    m_current_frame_info.started_time = std::chrono::steady_clock::now();
 
-    while (vk::Result::eTimeout == m_device.device().waitForFences({*frame_sync.fences.in_flight},
-                                                                   VK_TRUE,
-                                                                   std::numeric_limits<std::uint64_t>::max()))
-        ;
-    m_device.device().resetFences(*frame_sync.fences.in_flight);
+    frame.command_pool.reset();
+    frame.command_buffer.begin(vk::CommandBufferBeginInfo{vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+}
+
+void Renderer::end_frame() {
+    auto &frame = m_frames[m_current_frame_info.frame_index];
+    auto &frame_scheduler = m_device.frame_scheduler();
+    const auto &render_finished = m_render_finished_semaphores[m_current_frame_info.image_index];
+
+    frame.command_buffer.end();
+    m_frame_allocator.end_frame();
+
+    // everything enqueued for upload up to now (e.g. the meshes created this frame) goes in one transfer batch; the
+    // frame waits on it GPU-side, which is a no-op once the batch has completed
+    const auto upload_value = m_upload_service.submit();
+
+    const auto wait_semaphore_infos = std::array{
+            vk::SemaphoreSubmitInfo{*frame.semaphores.image_available,
+                                    0,
+                                    vk::PipelineStageFlagBits2::eColorAttachmentOutput},
+            vk::SemaphoreSubmitInfo{m_upload_service.timeline(),
+                                    upload_value,
+                                    vk::PipelineStageFlagBits2::eAllCommands}};
+    const auto command_buffer_info = vk::CommandBufferSubmitInfo{*frame.command_buffer};
+    const auto signal_semaphore_infos = std::array{
+            // the binary semaphore is for the presentation engine, which can't wait on a timeline
+            vk::SemaphoreSubmitInfo{*render_finished, 0, vk::PipelineStageFlagBits2::eAllCommands},
+            vk::SemaphoreSubmitInfo{frame_scheduler.timeline(),
+                                    frame_scheduler.current_frame(),
+                                    vk::PipelineStageFlagBits2::eAllCommands}};
+
+    m_device.queue_families().graphics.queue.submit2KHR(
+            vk::SubmitInfo2{{}, wait_semaphore_infos, command_buffer_info, signal_semaphore_infos});
+    frame_scheduler.end_frame();
 
     const auto present_info = vk::PresentInfoKHR{1,
-                                                 &*frame_sync.semaphores.render_finished,
+                                                 &*render_finished,
                                                  1,
                                                  &*m_swapchain->get(),
                                                  &m_current_frame_info.image_index};
@@ -312,33 +328,46 @@ void Renderer::end_frame() {
     }
 
     m_prev_frame_info.finished_time = m_device.frame_dt();
-    m_current_frame_info.frame_index = (m_current_frame_info.frame_index + 1) % g_max_frames_in_flight;
+    m_current_frame_info.frame_index = (m_current_frame_info.frame_index + 1) % m_frames_in_flight;
 }
 
 void Renderer::render(const render_context_s args) {
     begin_frame();
 
     const auto &camera = args.scene.camera();
-
-    m_resources.global_ubos[m_current_frame_info.frame_index].upload(
-            global_ubo_s{camera.matrices().projection_matrix, camera.matrices().view_matrix});
-    update_descriptor_sets(m_device.device(),
-                           m_resources.global_descriptor_sets[m_current_frame_info.frame_index],
-                           {{vk::DescriptorType::eUniformBuffer,
-                             m_resources.global_ubos[m_current_frame_info.frame_index].buffer,
-                             VK_WHOLE_SIZE,
-                             nullptr}},
-                           nullptr);
-
-    const auto &command_buffer = m_swapchain->command_buffers()[m_current_frame_info.image_index];
-
-    const auto render_args = render::render_args_s{
-            m_device,
-            m_swapchain,
-            command_buffer,
-            {.descriptor_set_layout = *m_resources.global_descriptor_set_layout,
-             .descriptor_set = *m_resources.global_descriptor_sets[m_current_frame_info.frame_index]}};
-    ;
+    const auto &camera_matrices = camera.matrices();
+
+    // camera-relative rendering: the camera sits at the origin, so the view matrix is only a rotation and every
+    // position uploaded, the light's included, is an offset from the camera (see `render_args_s::origin`)
+    const auto &origin = camera.eye_d().transform.position;
+    const auto view_matrix = glm::f32mat4{camera_matrices.view_rotation_matrix};
+    auto global_ubo_data = global_ubo_s{glm::f32mat4{camera_matrices.projection_matrix},
+                                        view_matrix,
+                                        glm::transpose(view_matrix)};
+    global_ubo_data.light_position = glm::f32vec3{glm::f64vec3{global_ubo_data.light_position} - origin};
+    const auto global_ubo = m_frame_allocator.push(global_ubo_data);
+
+    const auto render_args = render::render_args_s{m_device,
+                                                   m_swapchain,
+                                                   command_buffer(),
+                                                   m_frame_allocator,
+                                                   m_thread_pool,
+                                                   m_geometry_pool,
+                                                   args.scene.entities(),
+                                                   origin,
+                                                   cameras::frustum_s::from_view_projection(
+                                                           camera_matrices.projection_matrix *
+                                                           camera_matrices.view_rotation_matrix),
+                                                   cameras::lod_view_s::from_projection(
+                                                           glm::f64vec3{0.0},
+                                                           camera_matrices.projection_matrix,
+                                                           m_swapchain->extent().height),
+                                                   {.pipeline_layout = *m_resources.pipeline_layout,
+                                                    .descriptor_set_layout = m_resources.global_descriptor_set_layout,
+                                                    .descriptor_set = m_resources.global_descriptor_set,
+                                                    .bindless_descriptor_set = m_bindless_heap.set(),
+                                                    .frame_allocator_buffer_id = m_resources.frame_allocator_buffer_id,
+                                                    .dynamic_offset = global_ubo.dynamic_offset()}};
     m_gbuffer.render(render_args);
 
     end_frame();
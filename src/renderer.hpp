@@ -3,7 +3,7 @@
 
 #pragma once
 
-#include <array>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -14,19 +14,30 @@
 #include "primitive_graphics/mesh.hpp"
 #include "render/passes/gbuffer.hpp"
 #include "scene/scene.hpp"
+#include "util/thread_pool.hpp"
+#include "vulkan/bindless_heap.hpp"
+#include "vulkan/descriptor_cache.hpp"
 #include "vulkan/device.hpp"
+#include "vulkan/frame_allocator.hpp"
+#include "vulkan/geometry_pool.hpp"
+#include "vulkan/pipeline_registry.hpp"
 #include "vulkan/swapchain.hpp"
+#include "vulkan/upload_service.hpp"
 
 namespace sm::arcane {
 
-inline static constexpr auto g_max_frames_in_flight = 2u;
+// upper bound for `vulkan::config_s::frames_in_flight`
+inline static constexpr auto g_max_frames_in_flight = 4u;
 
 // Temporary pipeline struct. Will remove the struct in the future
 struct global_resources_s {
-    vk::raii::DescriptorPool global_descriptor_pool;
-    std::vector<vulkan::DeviceMemoryBuffer> global_ubos;
-    vk::raii::DescriptorSetLayout global_descriptor_set_layout;
-    std::vector<vk::raii::DescriptorSet> global_descriptor_sets;
+    // both are owned by `vulkan::DescriptorCache`
+    vk::DescriptorSetLayout global_descriptor_set_layout;
+    vk::DescriptorSet global_descriptor_set;
+    vulkan::bindless_id_t frame_allocator_buffer_id;
+
+    // the one layout every pipeline is created with: the sets bound once per pass stay valid across pipeline binds
+    vk::raii::PipelineLayout pipeline_layout = nullptr;
 };
 
 struct render_context_s {
@@ -37,35 +48,64 @@ class Renderer {
 public:
     Renderer(vulkan::Device &device,
              std::unique_ptr<vulkan::Swapchain> &swapchain,
+             std::uint32_t frames_in_flight,
+             util::ThreadPool &thread_pool,
              std::shared_ptr<spdlog::logger> renderer_logger);
 
     void begin_frame();
     void end_frame();
     void render(render_context_s args);
 
+    // must be called after the swapchain has been recreated, with the device idle
+    void on_swapchain_recreated();
+
     [[nodiscard]] const frame_info_s &frame_info() const noexcept { return m_current_frame_info; }
+    [[nodiscard]] vulkan::GeometryPool &geometry_pool() noexcept { return m_geometry_pool; }
 
 private:
+    [[nodiscard]] const vk::raii::CommandBuffer &command_buffer() const noexcept {
+        return m_frames[m_current_frame_info.frame_index].command_buffer;
+    }
+
+    void revalue_render_finished_semaphores();
+
     std::shared_ptr<spdlog::logger> m_logger;
     vulkan::Device &m_device;
     const std::unique_ptr<vulkan::Swapchain> &m_swapchain;
+    util::ThreadPool &m_thread_pool;
+
+    std::uint32_t m_frames_in_flight;
 
+    vulkan::FrameAllocator m_frame_allocator;
+    vulkan::DescriptorCache m_descriptor_cache;
+    vulkan::BindlessHeap m_bindless_heap;
     global_resources_s m_resources;
 
     frame_info_s &m_current_frame_info;
     prev_frame_info_s m_prev_frame_info{};
 
-    struct frame_sync_s {
+    // Everything a frame records into lives in its own slot indexed by `frame_info_s::frame_index`. A slot is
+    // reused only after the GPU has retired its previous submission (see `vulkan::FrameScheduler`), so the CPU records
+    // the next frame while the GPU is still executing the previous ones
+    struct frame_resources_s {
+        vk::raii::CommandPool command_pool = nullptr;
+        vk::raii::CommandBuffer command_buffer = nullptr;
+
         struct semaphores_s {
             vk::raii::Semaphore image_available = nullptr;
-            vk::raii::Semaphore render_finished = nullptr;
         } semaphores;
-
-        struct fences_s {
-            vk::raii::Fence in_flight = nullptr;
-        } fences;
     };
-    std::array<frame_sync_s, g_max_frames_in_flight> m_frame_syncs{};
+    std::vector<frame_resources_s> m_frames;
+
+    // indexed by `frame_info_s::image_index`: the presentation engine may still wait on the semaphore of an image
+    // when the same frame slot comes around again
+    std::vector<vk::raii::Semaphore> m_render_finished_semaphores;
+
+    vulkan::UploadService m_upload_service;
+    // the vertices and indices of every mesh; declared before the passes owning the meshes, which release into it
+    vulkan::GeometryPool m_geometry_pool;
+    // filled by the passes while they are constructed, compiled once right after
+    vulkan::PipelineRegistry m_pipeline_registry;
 
     render::passes::Gbuffer m_gbuffer;
 };
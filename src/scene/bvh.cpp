@@ -0,0 +1,376 @@
+#include "bvh.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+namespace sm::arcane::scene {
+
+namespace {
+
+constexpr auto g_no_item = std::numeric_limits<std::uint32_t>::max();
+// a leaf is never split below this many items: testing them one after another is cheaper than going down further
+constexpr auto g_max_leaf_items = std::uint32_t{4};
+// the candidate split planes per axis are the boundaries of this many bins of the item centers
+constexpr auto g_sah_bin_count = std::size_t{16};
+
+[[nodiscard]] aabb_s merge(const aabb_s &a, const aabb_s &b) noexcept {
+    return {.min = glm::min(a.min, b.min), .max = glm::max(a.max, b.max)};
+}
+
+[[nodiscard]] float surface_area(const aabb_s &bounds) noexcept {
+    const auto extent = glm::max(bounds.max - bounds.min, glm::f32vec3{0.0f});
+    return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+}
+
+[[nodiscard]] glm::f32vec3 center(const aabb_s &bounds) noexcept { return 0.5f * (bounds.min + bounds.max); }
+
+// The reciprocal of every component, kept finite: an infinite one would make `intersect_ray` multiply it by the zero
+// distance to a face of a box lying in the plane of the ray, which is NaN
+[[nodiscard]] glm::f32vec3 inverse_direction_of(const glm::f32vec3 &direction) noexcept {
+    constexpr auto min_component = 1.0e-20f;
+    auto inverse_direction = glm::f32vec3{};
+    for (auto i = glm::length_t{0}; i < 3; ++i) {
+        inverse_direction[i] = 1.0f / std::copysign(std::max(std::abs(direction[i]), min_component), direction[i]);
+    }
+    return inverse_direction;
+}
+
+// the distance along the ray to where it enters the box, if it does before `max_distance`
+[[nodiscard]] std::optional<float> intersect_ray(const glm::f32vec3 &origin,
+                                                 const glm::f32vec3 &inverse_direction,
+                                                 const float max_distance,
+                                                 const aabb_s &bounds) noexcept {
+    const auto t1 = (bounds.min - origin) * inverse_direction;
+    const auto t2 = (bounds.max - origin) * inverse_direction;
+    const auto t_min = glm::min(t1, t2);
+    const auto t_max = glm::max(t1, t2);
+    const auto entry = std::max({t_min.x, t_min.y, t_min.z, 0.0f});
+    const auto exit = std::min({t_max.x, t_max.y, t_max.z, max_distance});
+    return entry <= exit ? std::optional{entry} : std::nullopt;
+}
+
+} // namespace
+
+void Bvh::build(const EntityRegistry &entities) {
+    const auto &components = entities.components();
+    m_nodes.clear();
+    m_items.clear();
+    m_item_bounds.clear();
+    m_item_indices.clear();
+
+    // the origin is the mean position of the entities, so the boxes are small floats around it
+    auto position_sum = glm::f64vec3{0.0};
+    for (auto index = std::uint32_t{0}; index < entities.size(); ++index) {
+        if (components.meshes[index]) {
+            m_items.push_back(components.entities[index]);
+            position_sum += components.world_positions[index];
+        }
+    }
+    m_origin = m_items.empty() ? glm::f64vec3{0.0} : position_sum / static_cast<double>(m_items.size());
+    for (const auto entity : m_items) {
+        m_item_bounds.push_back(item_bounds(entities, entities.dense_index(entity)));
+    }
+
+    if (!m_items.empty()) {
+        m_nodes.reserve(2 * m_items.size() - 1);
+        m_nodes.emplace_back();
+        build_node(0, 0, static_cast<std::uint32_t>(m_items.size()));
+    }
+    // the build has reordered the items
+    for (auto item = std::uint32_t{0}; item < m_items.size(); ++item) {
+        const auto entity_index = m_items[item].index;
+        if (entity_index >= m_item_indices.size()) {
+            m_item_indices.resize(entity_index + 1, g_no_item);
+        }
+        m_item_indices[entity_index] = item;
+    }
+
+    m_refitted_version = entities.version();
+    m_is_refit_pending = false;
+    m_built_count = m_items.size();
+    m_inserted_count = 0;
+    m_removed_count = 0;
+}
+
+void Bvh::refit(const EntityRegistry &entities) {
+    const auto &versions = entities.components().versions;
+    auto is_changed = std::exchange(m_is_refit_pending, false);
+    for (auto item = std::size_t{0}; item < m_items.size(); ++item) {
+        if (m_items[item] == g_no_entity) {
+            continue;
+        }
+        const auto dense_index = entities.dense_index(m_items[item]);
+        if (versions[dense_index] > m_refitted_version) {
+            m_item_bounds[item] = item_bounds(entities, dense_index);
+            is_changed = true;
+        }
+    }
+    if (is_changed) {
+        refit_nodes();
+    }
+    m_refitted_version = entities.version();
+}
+
+void Bvh::insert(const EntityRegistry &entities, const entity_s entity) {
+    assert(!contains(entity) && "an entity can only be inserted once");
+
+    const auto item = static_cast<std::uint32_t>(m_items.size());
+    if (m_nodes.empty()) {
+        m_origin = entities.components().world_positions[entities.dense_index(entity)];
+    }
+    const auto bounds = item_bounds(entities, entities.dense_index(entity));
+    m_items.push_back(entity);
+    m_item_bounds.push_back(bounds);
+    if (entity.index >= m_item_indices.size()) {
+        m_item_indices.resize(entity.index + 1, g_no_item);
+    }
+    m_item_indices[entity.index] = item;
+    ++m_inserted_count;
+
+    if (m_nodes.empty()) {
+        m_nodes.push_back({.bounds = bounds, .first = item, .item_count = 1});
+        return;
+    }
+
+    // down the child the box enlarges the least, growing the boxes on the way
+    auto node_index = std::uint32_t{0};
+    while (m_nodes[node_index].item_count == 0) {
+        auto &node = m_nodes[node_index];
+        node.bounds = merge(node.bounds, bounds);
+        const auto enlargement = [this, &bounds](const std::uint32_t child) {
+            const auto &child_bounds = m_nodes[child].bounds;
+            return surface_area(merge(child_bounds, bounds)) - surface_area(child_bounds);
+        };
+        node_index = enlargement(node.first) <= enlargement(node.first + 1) ? node.first : node.first + 1;
+    }
+
+    auto &leaf = m_nodes[node_index];
+    if (leaf.first + leaf.item_count == item && leaf.item_count < g_max_leaf_items) {
+        // the items of the leaf are the last ones, so the new item simply extends them
+        leaf.bounds = merge(leaf.bounds, bounds);
+        ++leaf.item_count;
+        return;
+    }
+    // otherwise the leaf becomes the parent of itself and of a leaf of the new item
+    const auto previous_leaf = leaf;
+    const auto first_child = static_cast<std::uint32_t>(m_nodes.size());
+    m_nodes[node_index] = {.bounds = merge(previous_leaf.bounds, bounds), .first = first_child, .item_count = 0};
+    m_nodes.push_back(previous_leaf);
+    m_nodes.push_back({.bounds = bounds, .first = item, .item_count = 1});
+}
+
+void Bvh::remove(const entity_s entity) {
+    assert(contains(entity) && "only an entity of the tree can be removed");
+
+    const auto item = std::exchange(m_item_indices[entity.index], g_no_item);
+    m_items[item] = g_no_entity;
+    m_item_bounds[item] = aabb_s{};
+    ++m_removed_count;
+    m_is_refit_pending = true;
+}
+
+bool Bvh::contains(const entity_s entity) const noexcept {
+    return entity.index < m_item_indices.size() && m_item_indices[entity.index] != g_no_item &&
+           m_items[m_item_indices[entity.index]] == entity;
+}
+
+bool Bvh::is_degraded() const noexcept {
+    // past a quarter of the entities built, or a few of them for a small tree
+    constexpr auto min_changed_count = std::size_t{16};
+    return (m_inserted_count + m_removed_count) * 4 > std::max(m_built_count, min_changed_count);
+}
+
+std::optional<Bvh::ray_hit_s> Bvh::query_ray(const glm::f64vec3 &ray_origin,
+                                             const glm::f32vec3 &direction,
+                                             const float max_distance) const {
+    if (m_nodes.empty()) {
+        return std::nullopt;
+    }
+
+    const auto origin = glm::f32vec3{ray_origin - m_origin};
+    const auto inverse_direction = inverse_direction_of(direction);
+    auto closest_hit = std::optional<ray_hit_s>{};
+    auto closest_distance = max_distance;
+
+    // the nearer child first, so the farther one is mostly skipped once something closer has been hit
+    auto stack = std::vector<std::pair<std::uint32_t, float>>{};
+    if (const auto distance = intersect_ray(origin, inverse_direction, closest_distance, m_nodes.front().bounds)) {
+        stack.emplace_back(0, *distance);
+    }
+    while (!stack.empty()) {
+        const auto [node_index, node_distance] = stack.back();
+        stack.pop_back();
+        if (node_distance > closest_distance) {
+            continue;
+        }
+
+        const auto &node = m_nodes[node_index];
+        if (node.item_count == 0) {
+            const auto first = intersect_ray(origin, inverse_direction, closest_distance, m_nodes[node.first].bounds);
+            const auto second = intersect_ray(origin,
+                                              inverse_direction,
+                                              closest_distance,
+                                              m_nodes[node.first + 1].bounds);
+            const auto push_ordered = [&stack](const std::uint32_t near_index,
+                                               const std::optional<float> &near_distance,
+                                               const std::uint32_t far_index,
+                                               const std::optional<float> &far_distance) {
+                if (far_distance) {
+                    stack.emplace_back(far_index, *far_distance);
+                }
+                if (near_distance) {
+                    stack.emplace_back(near_index, *near_distance);
+                }
+            };
+            if (second && (!first || *second < *first)) {
+                push_ordered(node.first + 1, second, node.first, first);
+            } else {
+                push_ordered(node.first, first, node.first + 1, second);
+            }
+            continue;
+        }
+        for (auto item = node.first; item < node.first + node.item_count; ++item) {
+            if (m_items[item] == g_no_entity) {
+                continue;
+            }
+            if (const auto distance = intersect_ray(origin, inverse_direction, closest_distance, m_item_bounds[item])) {
+                closest_distance = *distance;
+                closest_hit = ray_hit_s{.entity = m_items[item], .distance = *distance};
+            }
+        }
+    }
+    return closest_hit;
+}
+
+aabb_s Bvh::item_bounds(const EntityRegistry &entities, const std::uint32_t dense_index) const noexcept {
+    const auto &components = entities.components();
+    const auto &mesh = components.meshes[dense_index];
+    assert(mesh && "only the entities having a mesh have bounds");
+
+    // like `EntityRegistry::update`, the world transform rotates by the conjugate of the orientation
+    const auto &bounds = mesh->bounds();
+    const auto &scale = components.world_scales[dense_index];
+    const auto offset = glm::conjugate(glm::f64quat{components.world_orientations[dense_index]}) *
+                        glm::f64vec3{scale * bounds.center};
+    const auto sphere_center = glm::f32vec3{components.world_positions[dense_index] - m_origin + offset};
+    const auto abs_scale = glm::abs(scale);
+    const auto radius = bounds.radius * std::max({abs_scale.x, abs_scale.y, abs_scale.z});
+    return {.min = sphere_center - radius, .max = sphere_center + radius};
+}
+
+void Bvh::build_node(const std::uint32_t node_index, const std::uint32_t first, const std::uint32_t count) {
+    auto bounds = aabb_s{};
+    auto center_bounds = aabb_s{};
+    for (auto item = first; item < first + count; ++item) {
+        bounds = merge(bounds, m_item_bounds[item]);
+        const auto item_center = center(m_item_bounds[item]);
+        center_bounds = merge(center_bounds, {.min = item_center, .max = item_center});
+    }
+    m_nodes[node_index] = {.bounds = bounds, .first = first, .item_count = count};
+    if (count <= g_max_leaf_items) {
+        return;
+    }
+
+    // the surface area heuristic: a split costs the areas of the two children weighted by their item counts, the
+    // chance of a query reaching a child being proportional to its area. The best candidate over all axes wins
+    struct bin_s {
+        aabb_s bounds;
+        std::uint32_t item_count = 0;
+    };
+    auto best_cost = static_cast<float>(count) * surface_area(bounds);
+    auto best_axis = -1;
+    auto best_split = 0.0f;
+    for (auto axis = 0; axis < 3; ++axis) {
+        const auto center_min = center_bounds.min[axis];
+        const auto center_extent = center_bounds.max[axis] - center_min;
+        if (center_extent <= 0.0f) {
+            continue;
+        }
+
+        const auto bin_of = [center_min, center_extent](const float value) {
+            const auto bin = static_cast<std::size_t>((value - center_min) / center_extent * g_sah_bin_count);
+            return std::min(bin, g_sah_bin_count - 1);
+        };
+        auto bins = std::array<bin_s, g_sah_bin_count>{};
+        for (auto item = first; item < first + count; ++item) {
+            auto &bin = bins[bin_of(center(m_item_bounds[item])[axis])];
+            bin.bounds = merge(bin.bounds, m_item_bounds[item]);
+            ++bin.item_count;
+        }
+
+        // the costs of the left sides of the candidate planes, then those of the right sides from the other end
+        auto left_costs = std::array<float, g_sah_bin_count - 1>{};
+        auto left = bin_s{};
+        for (auto plane = std::size_t{0}; plane + 1 < g_sah_bin_count; ++plane) {
+            left.bounds = merge(left.bounds, bins[plane].bounds);
+            left.item_count += bins[plane].item_count;
+            left_costs[plane] = static_cast<float>(left.item_count) * surface_area(left.bounds);
+        }
+        auto right = bin_s{};
+        for (auto plane = g_sah_bin_count - 1; plane > 0; --plane) {
+            right.bounds = merge(right.bounds, bins[plane].bounds);
+            right.item_count += bins[plane].item_count;
+            if (right.item_count == 0 || right.item_count == count) {
+                continue;
+            }
+            if (const auto cost = left_costs[plane - 1] + static_cast<float>(right.item_count) *
+                                                                  surface_area(right.bounds);
+                cost < best_cost) {
+                best_cost = cost;
+                best_axis = axis;
+                best_split = center_min + center_extent * static_cast<float>(plane) / g_sah_bin_count;
+            }
+        }
+    }
+
+    auto left_count = count / 2;
+    if (best_axis >= 0) {
+        // the items are partitioned in place, so the items of every subtree stay contiguous
+        auto middle = first;
+        for (auto item = first; item < first + count; ++item) {
+            if (center(m_item_bounds[item])[best_axis] < best_split) {
+                std::swap(m_items[item], m_items[middle]);
+                std::swap(m_item_bounds[item], m_item_bounds[middle]);
+                ++middle;
+            }
+        }
+        left_count = middle - first;
+    } else if (count <= 2 * g_max_leaf_items) {
+        // no split is worth it, and the leaf would not be too large to test
+        return;
+    }
+    // with every center at the same place, or an unlucky rounding at the bin edges, the items are split in half
+    if (left_count == 0 || left_count == count) {
+        left_count = count / 2;
+    }
+
+    const auto first_child = static_cast<std::uint32_t>(m_nodes.size());
+    m_nodes[node_index] = {.bounds = bounds, .first = first_child, .item_count = 0};
+    m_nodes.emplace_back();
+    m_nodes.emplace_back();
+    build_node(first_child, first, left_count);
+    build_node(first_child + 1, first + left_count, count - left_count);
+}
+
+void Bvh::refit_nodes() noexcept {
+    for (auto node_index = m_nodes.size(); node_index-- > 0;) {
+        auto &node = m_nodes[node_index];
+        auto bounds = aabb_s{};
+        if (node.item_count == 0) {
+            bounds = merge(m_nodes[node.first].bounds, m_nodes[node.first + 1].bounds);
+        } else {
+            for (auto item = node.first; item < node.first + node.item_count; ++item) {
+                bounds = merge(bounds, m_item_bounds[item]);
+            }
+        }
+        node.bounds = bounds;
+    }
+}
+
+} // namespace sm::arcane::scene
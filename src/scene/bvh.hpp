@@ -0,0 +1,105 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <glm/fwd.hpp>
+#include <glm/vec3.hpp>
+
+#include "scene/entity_registry.hpp"
+
+namespace sm::arcane::scene {
+
+// relative to `Bvh::origin`; empty, intersecting nothing, unless `min <= max`
+struct aabb_s {
+    glm::f32vec3 min{std::numeric_limits<float>::max()};
+    glm::f32vec3 max{std::numeric_limits<float>::lowest()};
+};
+
+// A bounding volume hierarchy over the world bounds of the entities having a mesh: the bounding sphere of the mesh
+// (`primitive_graphics::Mesh::bounds`) transformed by the entity's world transform, as a box. Answers which entity a
+// ray hits first (picking) in time logarithmic in the number of entities rather than linear.
+//
+// The nodes are one flat array, 32 bytes each, with the two children of an inner node next to each other after their
+// parent. `build` lays the whole tree out depth first with the surface area heuristic, the best tree for content that
+// stays in place; `refit` then follows the entities that move, only growing or shrinking the boxes, and `insert` and
+// `remove` change the set of entities without a rebuild. Both make the tree worse over time: `is_degraded` tells when
+// building it again pays off.
+//
+// The boxes are floats relative to an origin picked by `build`, so their precision does not depend on the distance of
+// the content from the world origin; the queries take world positions in double precision
+class Bvh {
+public:
+    struct node_s {
+        aabb_s bounds;
+        // of the first child for an inner node, the second one follows it; of the first item for a leaf
+        std::uint32_t first = 0;
+        // of a leaf, 0 for an inner node
+        std::uint32_t item_count = 0;
+    };
+
+    struct ray_hit_s {
+        entity_s entity;
+        // along the ray, to where it enters the entity's box
+        float distance = 0.0f;
+    };
+
+    // builds the tree of every entity having a mesh from scratch
+    void build(const EntityRegistry &entities);
+    // Recomputes the boxes of the entities whose world transforms have changed since the last `build` or `refit`, then
+    // those of the nodes above them. The structure of the tree stays as it is; every entity in it must still be alive
+    void refit(const EntityRegistry &entities);
+    // adds an entity having a mesh, in the leaf its box enlarges the least
+    void insert(const EntityRegistry &entities, entity_s entity);
+    // its box is left empty in its leaf, and the nodes above it are only shrunk by the next `refit`
+    void remove(entity_s entity);
+
+    [[nodiscard]] bool contains(entity_s entity) const noexcept;
+    // the number of entities in the tree
+    [[nodiscard]] std::size_t size() const noexcept { return m_items.size() - m_removed_count; }
+    // Whether so many entities have been inserted or removed since the last `build` that rebuilding the tree would make
+    // the queries noticeably faster
+    [[nodiscard]] bool is_degraded() const noexcept;
+
+    [[nodiscard]] const glm::f64vec3 &origin() const noexcept { return m_origin; }
+    [[nodiscard]] std::span<const node_s> nodes() const noexcept { return m_nodes; }
+
+    // the entity whose box the ray enters first, within `max_distance`; `direction` is normalized
+    [[nodiscard]] std::optional<ray_hit_s> query_ray(const glm::f64vec3 &ray_origin,
+                                                     const glm::f32vec3 &direction,
+                                                     float max_distance = std::numeric_limits<float>::max()) const;
+
+private:
+    // the box of an entity having a mesh, as of the last update of the registry
+    [[nodiscard]] aabb_s item_bounds(const EntityRegistry &entities, std::uint32_t dense_index) const noexcept;
+    // lays out the subtree of the items [first, first + count) below `node_index`
+    void build_node(std::uint32_t node_index, std::uint32_t first, std::uint32_t count);
+    // recomputes the box of every node from its items or its children, the children coming after their parents
+    void refit_nodes() noexcept;
+
+    glm::f64vec3 m_origin{0.0};
+    std::vector<node_s> m_nodes;
+
+    // the items of the leaves: an entity, `g_no_entity` once removed, and its box
+    std::vector<entity_s> m_items;
+    std::vector<aabb_s> m_item_bounds;
+    // by `entity_s::index`
+    std::vector<std::uint32_t> m_item_indices;
+
+    // as of the last `build` or `refit`: the entities changed by later updates of the registry are refitted
+    std::uint64_t m_refitted_version = 0;
+    // the boxes of removed entities are emptied, those of the nodes above them are left to `refit`
+    bool m_is_refit_pending = false;
+    std::size_t m_built_count = 0;
+    std::size_t m_inserted_count = 0;
+    std::size_t m_removed_count = 0;
+};
+
+} // namespace sm::arcane::scene
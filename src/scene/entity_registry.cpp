@@ -0,0 +1,364 @@
+#include "entity_registry.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include <glm/geometric.hpp>
+#include <glm/trigonometric.hpp>
+
+namespace sm::arcane::scene {
+
+namespace {
+
+constexpr auto g_no_dense_index = std::numeric_limits<std::uint32_t>::max();
+
+[[nodiscard]] bool is_uniform(const glm::f32vec3 &scale) noexcept {
+    const auto [min_scale, max_scale] = std::minmax({scale.x, scale.y, scale.z});
+    return max_scale - min_scale <= 1e-5f * max_scale;
+}
+
+// either quaternion of the identity
+[[nodiscard]] bool is_identity(const glm::f32quat &orientation) noexcept {
+    return std::abs(orientation.w) >= 1.0f - 1e-6f;
+}
+
+struct rotation_scale_s {
+    glm::f32quat orientation;
+    glm::f32vec3 scale;
+};
+
+// The world orientation and scale of a child rotated relative to a parent whose world scale is not uniform: the product
+// of their matrices skews, which no orientation and scale can hold, so it is multiplied out and they are taken from it:
+// the child's x axis keeps its world direction and length, its y axis the plane it spans with x; only the skew is lost
+// (`std::nullopt` for an axis scaled to nothing)
+[[nodiscard]] std::optional<rotation_scale_s> compose_skewed(const glm::f32quat &parent_orientation,
+                                                             const glm::f32vec3 &parent_scale,
+                                                             const glm::f32quat &orientation,
+                                                             const glm::f32vec3 &scale) noexcept {
+    // the upper 3x3 of the model matrices, which rotate by the conjugate (see `cameras::model_matrix`)
+    auto parent_matrix = glm::mat3_cast(glm::conjugate(parent_orientation));
+    auto matrix = glm::mat3_cast(glm::conjugate(orientation));
+    for (auto i = glm::length_t{0}; i < 3; ++i) {
+        parent_matrix[i] *= parent_scale[i];
+        matrix[i] *= scale[i];
+    }
+    const auto world_matrix = parent_matrix * matrix;
+
+    constexpr auto min_length = 1e-12f;
+    const auto x_length = glm::length(world_matrix[0]);
+    if (x_length < min_length) {
+        return std::nullopt;
+    }
+    const auto x = world_matrix[0] / x_length;
+    const auto y_perpendicular = world_matrix[1] - glm::dot(world_matrix[1], x) * x;
+    const auto y_length = glm::length(y_perpendicular);
+    if (y_length < min_length) {
+        return std::nullopt;
+    }
+    const auto y = y_perpendicular / y_length;
+    const auto z = glm::cross(x, y);
+
+    // a negative z scale keeps a mirroring parent scale mirroring
+    return rotation_scale_s{.orientation = glm::conjugate(glm::quat_cast(glm::f32mat3{x, y, z})),
+                            .scale = {x_length, y_length, glm::dot(world_matrix[2], z)}};
+}
+
+template<typename T>
+void gather(std::vector<T> &values, const std::vector<std::uint32_t> &order) {
+    auto gathered = std::vector<T>{};
+    gathered.reserve(order.size());
+    for (const auto index : order) {
+        gathered.push_back(std::move(values[index]));
+    }
+    values = std::move(gathered);
+}
+
+} // namespace
+
+entity_s EntityRegistry::create(std::shared_ptr<primitive_graphics::Mesh> mesh, const entity_s parent) {
+    assert((parent == g_no_entity || is_alive(parent)) && "the parent of an entity must be alive");
+
+    auto &components = m_components;
+    const auto index = static_cast<std::uint32_t>(components.entities.size());
+    auto entity = entity_s{};
+    if (m_free_indices.empty()) {
+        entity.index = static_cast<std::uint32_t>(m_generations.size());
+        m_generations.push_back(0);
+        m_dense_indices.push_back(index);
+    } else {
+        entity.index = m_free_indices.back();
+        m_free_indices.pop_back();
+        m_dense_indices[entity.index] = index;
+    }
+    entity.generation = m_generations[entity.index];
+
+    // appended after every entity alive, so after its parent too
+    components.entities.push_back(entity);
+    components.parents.push_back(parent == g_no_entity ? no_parent : dense_index(parent));
+    components.positions.push_back(cameras::g_default_position);
+    components.orientations.push_back(g_identity_orientation);
+    components.scales.push_back(cameras::g_default_scale);
+    components.world_positions.push_back(cameras::g_default_position);
+    components.world_orientations.push_back(g_identity_orientation);
+    components.world_scales.push_back(cameras::g_default_scale);
+    components.versions.push_back(0);
+    components.meshes.push_back(std::move(mesh));
+    components.colors.emplace_back(1.0f);
+    m_changed.push_back(1);
+
+    ++m_structure_version;
+    return entity;
+}
+
+void EntityRegistry::destroy(const entity_s entity) {
+    // the descendants are found in one pass only while the parents precede them
+    if (m_order_broken) {
+        restore_order();
+    }
+
+    const auto &parents = m_components.parents;
+    const auto root = dense_index(entity);
+    auto destroyed = std::vector<std::uint8_t>(size(), 0);
+    destroyed[root] = 1;
+    auto order = std::vector<std::uint32_t>{};
+    order.reserve(size());
+    for (auto index = std::uint32_t{0}; index < size(); ++index) {
+        if (parents[index] != no_parent && destroyed[parents[index]]) {
+            destroyed[index] = 1;
+        }
+        if (!destroyed[index]) {
+            order.push_back(index);
+            continue;
+        }
+
+        // the handles of the destroyed entities must never match their slot again
+        const auto entity_index = m_components.entities[index].index;
+        ++m_generations[entity_index];
+        m_dense_indices[entity_index] = g_no_dense_index;
+        m_free_indices.push_back(entity_index);
+    }
+    permute(order);
+}
+
+bool EntityRegistry::is_alive(const entity_s entity) const noexcept {
+    return entity.index < m_generations.size() && m_generations[entity.index] == entity.generation &&
+           m_dense_indices[entity.index] != g_no_dense_index;
+}
+
+void EntityRegistry::set_parent(const entity_s entity, const entity_s parent) {
+    const auto index = dense_index(entity);
+    auto &parents = m_components.parents;
+    if (parent == g_no_entity) {
+        parents[index] = no_parent;
+    } else {
+        const auto parent_index = dense_index(parent);
+        for (auto ancestor = parent_index; ancestor != no_parent; ancestor = parents[ancestor]) {
+            if (ancestor == index) {
+                throw std::runtime_error{"An entity can't be parented to itself or to any of its descendants"};
+            }
+        }
+        parents[index] = parent_index;
+        // restored by the next `update`, all at once however many entities are reparented until then
+        m_order_broken = m_order_broken || parent_index > index;
+    }
+    mark_changed(index);
+}
+
+void EntityRegistry::set_position(const entity_s entity, const glm::f64vec3 &position) noexcept {
+    const auto index = dense_index(entity);
+    m_components.positions[index] = position;
+    mark_changed(index);
+}
+
+void EntityRegistry::set_orientation(const entity_s entity, const glm::f32quat &orientation) noexcept {
+    const auto index = dense_index(entity);
+    m_components.orientations[index] = orientation;
+    mark_changed(index);
+}
+
+void EntityRegistry::rotate(const entity_s entity, const float degrees, const glm::f32vec3 &axis) noexcept {
+    const auto index = dense_index(entity);
+    const auto rotation = glm::angleAxis(glm::radians(degrees), glm::normalize(axis));
+
+    m_components.orientations[index] = rotation * m_components.orientations[index];
+    mark_changed(index);
+}
+
+void EntityRegistry::set_scale(const entity_s entity, const float scale) noexcept {
+    set_scale(entity, glm::f32vec3{scale});
+}
+
+void EntityRegistry::set_scale(const entity_s entity, const glm::f32vec3 &scale) noexcept {
+    const auto index = dense_index(entity);
+    m_components.scales[index] = scale;
+    mark_changed(index);
+}
+
+void EntityRegistry::set_mesh(const entity_s entity, std::shared_ptr<primitive_graphics::Mesh> mesh) noexcept {
+    m_components.meshes[dense_index(entity)] = std::move(mesh);
+    ++m_structure_version;
+}
+
+void EntityRegistry::set_color(const entity_s entity, const glm::f32vec3 &color) noexcept {
+    const auto index = dense_index(entity);
+    m_components.colors[index] = color;
+    mark_changed(index);
+}
+
+entity_s EntityRegistry::parent(const entity_s entity) const noexcept {
+    const auto parent_index = m_components.parents[dense_index(entity)];
+    return parent_index == no_parent ? g_no_entity : m_components.entities[parent_index];
+}
+
+cameras::transform_object_s EntityRegistry::local_transform(const entity_s entity) const noexcept {
+    const auto index = dense_index(entity);
+    auto transform = cameras::transform_object_s{};
+    transform.position = m_components.positions[index];
+    transform.orientation = m_components.orientations[index];
+    transform.scale = m_components.scales[index];
+    return transform;
+}
+
+cameras::transform_object_s EntityRegistry::world_transform(const entity_s entity) const noexcept {
+    const auto index = dense_index(entity);
+    auto transform = cameras::transform_object_s{};
+    transform.position = m_components.world_positions[index];
+    transform.orientation = m_components.world_orientations[index];
+    transform.scale = m_components.world_scales[index];
+    return transform;
+}
+
+glm::f64mat4 EntityRegistry::model_matrix(const entity_s entity) const noexcept {
+    return world_transform(entity).model_matrix();
+}
+
+glm::f32mat3 EntityRegistry::normal_matrix(const entity_s entity) const noexcept {
+    return world_transform(entity).normal_matrix();
+}
+
+std::uint32_t EntityRegistry::dense_index(const entity_s entity) const noexcept {
+    assert(is_alive(entity) && "the entity has been destroyed");
+    return m_dense_indices[entity.index];
+}
+
+void EntityRegistry::update() {
+    if (m_order_broken) {
+        restore_order();
+    }
+
+    // an entity is recomputed if it has changed or its parent has been recomputed by this very update, which the
+    // order of the arrays guarantees to be known by then
+    ++m_version;
+    auto &components = m_components;
+    for (auto index = std::size_t{0}; index < size(); ++index) {
+        const auto parent = components.parents[index];
+        if (!m_changed[index] && (parent == no_parent || components.versions[parent] != m_version)) {
+            continue;
+        }
+
+        if (parent == no_parent) {
+            components.world_positions[index] = components.positions[index];
+            components.world_orientations[index] = components.orientations[index];
+            components.world_scales[index] = components.scales[index];
+        } else {
+            // `cameras::model_matrix` rotates by the conjugate of the orientation: the parent's rotation applies last,
+            // so its quaternion comes last
+            const auto &parent_orientation = components.world_orientations[parent];
+            const auto &parent_scale = components.world_scales[parent];
+            const auto offset = glm::conjugate(glm::f64quat{parent_orientation}) *
+                                (glm::f64vec3{parent_scale} * components.positions[index]);
+            components.world_positions[index] = components.world_positions[parent] + offset;
+            components.world_orientations[index] = components.orientations[index] * parent_orientation;
+            components.world_scales[index] = parent_scale * components.scales[index];
+
+            // a non-uniform scale applied after a rotation is a skew, which a scale per axis can't hold
+            if (!is_uniform(parent_scale) && !is_identity(components.orientations[index])) {
+                if (const auto composed = compose_skewed(parent_orientation,
+                                                         parent_scale,
+                                                         components.orientations[index],
+                                                         components.scales[index])) {
+                    components.world_orientations[index] = composed->orientation;
+                    components.world_scales[index] = composed->scale;
+                }
+            }
+        }
+        components.versions[index] = m_version;
+        m_changed[index] = 0;
+    }
+}
+
+void EntityRegistry::mark_changed(const std::uint32_t index) noexcept { m_changed[index] = 1; }
+
+void EntityRegistry::restore_order() {
+    // sorting by depth in the hierarchy, stably, puts the parents first
+    constexpr auto unknown_depth = std::numeric_limits<std::uint32_t>::max();
+    const auto &parents = m_components.parents;
+    auto depths = std::vector<std::uint32_t>(size(), unknown_depth);
+    auto max_depth = std::uint32_t{0};
+    auto path = std::vector<std::uint32_t>{};
+    for (auto index = std::uint32_t{0}; index < size(); ++index) {
+        auto ancestor = index;
+        while (ancestor != no_parent && depths[ancestor] == unknown_depth) {
+            path.push_back(ancestor);
+            ancestor = parents[ancestor];
+        }
+        auto depth = ancestor == no_parent ? std::uint32_t{0} : depths[ancestor] + 1;
+        for (auto it = path.rbegin(); it != path.rend(); ++it) {
+            depths[*it] = depth++;
+        }
+        max_depth = std::max(max_depth, depths[index]);
+        path.clear();
+    }
+
+    auto depth_offsets = std::vector<std::uint32_t>(max_depth + 1, 0);
+    for (const auto depth : depths) {
+        ++depth_offsets[depth];
+    }
+    for (auto depth = std::uint32_t{0}, first = std::uint32_t{0}; depth <= max_depth; ++depth) {
+        first += std::exchange(depth_offsets[depth], first);
+    }
+    auto order = std::vector<std::uint32_t>(size());
+    for (auto index = std::uint32_t{0}; index < size(); ++index) {
+        order[depth_offsets[depths[index]]++] = index;
+    }
+
+    permute(order);
+    m_order_broken = false;
+}
+
+void EntityRegistry::permute(const std::vector<std::uint32_t> &order) {
+    auto &components = m_components;
+    auto dense_indices = std::vector<std::uint32_t>(size(), no_parent);
+    for (auto index = std::uint32_t{0}; index < order.size(); ++index) {
+        dense_indices[order[index]] = index;
+    }
+
+    gather(components.entities, order);
+    gather(components.parents, order);
+    for (auto &parent : components.parents) {
+        if (parent != no_parent) {
+            parent = dense_indices[parent];
+        }
+    }
+    gather(components.positions, order);
+    gather(components.orientations, order);
+    gather(components.scales, order);
+    gather(components.world_positions, order);
+    gather(components.world_orientations, order);
+    gather(components.world_scales, order);
+    gather(components.versions, order);
+    gather(components.meshes, order);
+    gather(components.colors, order);
+    gather(m_changed, order);
+
+    for (auto index = std::uint32_t{0}; index < components.entities.size(); ++index) {
+        m_dense_indices[components.entities[index].index] = index;
+    }
+    ++m_structure_version;
+}
+
+} // namespace sm::arcane::scene
@@ -0,0 +1,136 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <glm/fwd.hpp>
+#include <glm/gtx/quaternion.hpp>
+#include <glm/mat3x3.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include "cameras/transform.hpp"
+#include "primitive_graphics/mesh.hpp"
+
+namespace sm::arcane::scene {
+
+// Refers to an entity of an `EntityRegistry`. Stays valid, whatever the entity's storage is moved to, until the entity
+// is destroyed; a destroyed entity's handle is never valid again, even once its slot is reused
+struct entity_s {
+    std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+    std::uint32_t generation = 0;
+
+    [[nodiscard]] bool operator==(const entity_s &) const noexcept = default;
+};
+
+inline constexpr auto g_no_entity = entity_s{};
+
+// `w` first; unlike `cameras::g_default_orientation`, composes with other orientations
+inline constexpr auto g_identity_orientation = glm::f32quat{1.0f, 0.0f, 0.0f, 0.0f};
+
+// The entities of a scene: a transform relative to an optional parent, and what they are drawn with. Every component
+// is stored in its own dense array (structure of arrays), all of them indexed by the entity's dense index, so the
+// systems going over all the entities only touch the components they use, contiguously.
+//
+// Parents always precede their children in the arrays, which turns the propagation of the transforms down the
+// hierarchy into a single forward pass. Changing a local transform only marks the entity: `update` recomputes the world
+// transforms of the marked entities and of their descendants, nothing else.
+//
+// World transforms are kept as a position, an orientation and a scale too, so the matrices of any number of entities
+// are computed in batches (see `cameras::compute_matrices`). That is only exact while no transform has to skew: for a
+// child rotated relative to a parent whose world scale is not uniform, `update` multiplies their matrices out and takes
+// the orientation and the scale from the product, losing only the skew
+class EntityRegistry {
+public:
+    // of `components_s::parents`
+    inline static constexpr auto no_parent = std::numeric_limits<std::uint32_t>::max();
+
+    struct components_s {
+        std::vector<entity_s> entities;
+        // the dense index of the parent, always lower than the entity's own
+        std::vector<std::uint32_t> parents;
+
+        // relative to the parent
+        std::vector<glm::f64vec3> positions;
+        std::vector<glm::f32quat> orientations;
+        std::vector<glm::f32vec3> scales;
+
+        // in world space, up to date as of the last `update`
+        std::vector<glm::f64vec3> world_positions;
+        std::vector<glm::f32quat> world_orientations;
+        std::vector<glm::f32vec3> world_scales;
+        // the `EntityRegistry::version` of the `update` that last changed the world transforms or the color
+        std::vector<std::uint64_t> versions;
+
+        // may be empty: an entity without a mesh only carries a transform for its children
+        std::vector<std::shared_ptr<primitive_graphics::Mesh>> meshes;
+        std::vector<glm::f32vec3> colors;
+    };
+
+    [[nodiscard]] entity_s create(std::shared_ptr<primitive_graphics::Mesh> mesh = nullptr,
+                                  entity_s parent = g_no_entity);
+    // destroys the descendants of the entity as well
+    void destroy(entity_s entity);
+
+    [[nodiscard]] bool is_alive(entity_s entity) const noexcept;
+    [[nodiscard]] std::size_t size() const noexcept { return m_components.entities.size(); }
+
+    // the entity keeps its local transform, so it moves along with its new parent
+    void set_parent(entity_s entity, entity_s parent);
+    void set_position(entity_s entity, const glm::f64vec3 &position) noexcept;
+    void set_orientation(entity_s entity, const glm::f32quat &orientation) noexcept;
+    // rotates the entity about `axis`, after its current orientation
+    void rotate(entity_s entity, float degrees, const glm::f32vec3 &axis) noexcept;
+    void set_scale(entity_s entity, float scale) noexcept;
+    void set_scale(entity_s entity, const glm::f32vec3 &scale) noexcept;
+    void set_mesh(entity_s entity, std::shared_ptr<primitive_graphics::Mesh> mesh) noexcept;
+    void set_color(entity_s entity, const glm::f32vec3 &color) noexcept;
+
+    [[nodiscard]] entity_s parent(entity_s entity) const noexcept;
+    [[nodiscard]] cameras::transform_object_s local_transform(entity_s entity) const noexcept;
+    [[nodiscard]] cameras::transform_object_s world_transform(entity_s entity) const noexcept;
+    // of the world transform
+    [[nodiscard]] glm::f64mat4 model_matrix(entity_s entity) const noexcept;
+    [[nodiscard]] glm::f32mat3 normal_matrix(entity_s entity) const noexcept;
+
+    [[nodiscard]] std::uint32_t dense_index(entity_s entity) const noexcept;
+    [[nodiscard]] const components_s &components() const noexcept { return m_components; }
+
+    // Restores the order of the arrays if the hierarchy has changed, then recomputes the world transforms of the
+    // changed entities and their descendants
+    void update();
+
+    // incremented by every `update`
+    [[nodiscard]] std::uint64_t version() const noexcept { return m_version; }
+    // incremented whenever an entity is created, destroyed or given another mesh, or the arrays are reordered: the
+    // dense indices and the meshes kept by the systems are stale then
+    [[nodiscard]] std::uint64_t structure_version() const noexcept { return m_structure_version; }
+
+private:
+    void mark_changed(std::uint32_t index) noexcept;
+    // brings every parent before its children again, keeping the order of the entities otherwise
+    void restore_order();
+    // moves the entity at every `order[i]` to `i`, dropping those left out
+    void permute(const std::vector<std::uint32_t> &order);
+
+    components_s m_components;
+    // whether the local transform or the color of an entity changed since the last `update`
+    std::vector<std::uint8_t> m_changed;
+
+    // by `entity_s::index`
+    std::vector<std::uint32_t> m_dense_indices;
+    std::vector<std::uint32_t> m_generations;
+    std::vector<std::uint32_t> m_free_indices;
+
+    bool m_order_broken = false;
+    std::uint64_t m_version = 0;
+    std::uint64_t m_structure_version = 0;
+};
+
+} // namespace sm::arcane::scene
@@ -1,18 +1,215 @@
 #include "scene.hpp"
 
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <system_error>
+#include <tuple>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+#include "primitive_graphics/mesh.hpp"
+#include "primitive_graphics/mesh_optimizer.hpp"
+#include "primitive_graphics/mesh_simplifier.hpp"
+#include "primitive_graphics/meshlet_builder.hpp"
+#include "primitive_graphics/obj_loader.hpp"
 #include "scene/viewpoint.hpp"
+#include "util/filesystem_helpers.hpp"
 
 namespace sm::arcane::scene {
 
-Scene::Scene(Window &window, const vulkan::Device &device, const std::unique_ptr<vulkan::Swapchain> &swapchain)
+namespace {
+
+[[nodiscard]] std::shared_ptr<spdlog::logger> logger() {
+    static const auto scene_logger = spdlog::default_logger()->clone("scene");
+    return scene_logger;
+}
+
+// the model of the scene, if there is one
+[[nodiscard]] std::filesystem::path model_path() {
+    return util::application_directory_path() / "assets" / "models" / "model.obj";
+}
+
+// written once from the model, then mapped by the next runs instead of parsing the model again
+[[nodiscard]] std::filesystem::path model_cache_path() {
+    return std::filesystem::path{SM_ARCANE_CACHE_DIR_PATH} / "models" / "model.mesh";
+}
+
+// whether the cache was written after the model was last changed; a cache without its model is used as it is
+[[nodiscard]] bool is_cache_up_to_date(const std::filesystem::path &cache_path,
+                                       const std::filesystem::path &source_path) {
+    auto error = std::error_code{};
+    const auto cache_time = std::filesystem::last_write_time(cache_path, error);
+    if (error) {
+        return false;
+    }
+    const auto source_time = std::filesystem::last_write_time(source_path, error);
+    return error || cache_time >= source_time;
+}
+
+// what `arcane_mesh_converter` does, with compact vertices: the model is a dense mesh
+void write_model_cache(primitive_graphics::mesh_data_s mesh_data, const std::filesystem::path &cache_path) {
+    primitive_graphics::generate_lods(mesh_data);
+    std::ignore = primitive_graphics::optimize_mesh(mesh_data);
+    primitive_graphics::build_meshlets(mesh_data);
+
+    std::filesystem::create_directories(cache_path.parent_path());
+    primitive_graphics::write_mesh_cache(cache_path, mesh_data, primitive_graphics::vertex_format_e::compact);
+}
+
+template<typename T>
+[[nodiscard]] bool is_ready(const std::future<T> &future) {
+    return future.valid() && future.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+}
+
+} // namespace
+
+Scene::Scene(Window &window,
+             const vulkan::Device &device,
+             const std::unique_ptr<vulkan::Swapchain> &swapchain,
+             vulkan::GeometryPool &geometry_pool,
+             util::ThreadPool &thread_pool)
     : m_window{window},
       m_device{device},
       m_swapchain_uptr{swapchain},
-      m_camera{swapchain->aspect_ratio()} {}
+      m_geometry_pool{geometry_pool},
+      m_thread_pool{thread_pool},
+      m_camera{swapchain->aspect_ratio()} {
+    create_entities();
+    load_model();
+}
 
 cameras::Camera &Scene::camera() { return m_camera; }
 
-void Scene::update() { update_camera_state(); }
+void Scene::update() {
+    update_camera_state();
+    update_model();
+    m_entities.update();
+    update_picking();
+}
+
+const Bvh &Scene::bvh() {
+    if (m_bvh_version != m_entities.version()) {
+        update_bvh();
+        m_bvh_version = m_entities.version();
+    }
+    return m_bvh;
+}
+
+std::optional<Bvh::ray_hit_s> Scene::pick(const float max_distance) {
+    const auto &transform = m_camera.eye_d().transform;
+    return bvh().query_ray(transform.position, transform.directions.forward, max_distance);
+}
+
+void Scene::update_bvh() {
+    // the tree is built again whenever entities come or go, otherwise it only follows those which have moved
+    if (m_bvh_structure_version != m_entities.structure_version() || m_bvh.is_degraded()) {
+        m_bvh.build(m_entities);
+        m_bvh_structure_version = m_entities.structure_version();
+    } else {
+        m_bvh.refit(m_entities);
+    }
+}
+
+void Scene::update_picking() {
+    constexpr auto highlight_color = glm::f32vec3{1.0f, 1.0f, 1.0f};
+
+    const auto hit = m_window.is_key_pressed(keyboard_key_e::space) ? pick() : std::nullopt;
+    const auto picked_entity = hit ? hit->entity : g_no_entity;
+    if (picked_entity == m_picked_entity) {
+        return;
+    }
+
+    // the colors are applied by the next update of the registry
+    if (m_picked_entity != g_no_entity && m_entities.is_alive(m_picked_entity)) {
+        m_entities.set_color(m_picked_entity, m_picked_color);
+    }
+    m_picked_entity = picked_entity;
+    if (m_picked_entity != g_no_entity) {
+        m_picked_color = m_entities.components().colors[m_entities.dense_index(m_picked_entity)];
+        m_entities.set_color(m_picked_entity, highlight_color);
+    }
+}
+
+void Scene::create_entities() {
+    auto mesh = std::make_shared<primitive_graphics::Mesh>(m_geometry_pool,
+                                                           primitive_graphics::blanks::cube_normal_vertices,
+                                                           primitive_graphics::blanks::cube_indices);
+    auto prop_mesh = std::make_shared<primitive_graphics::Mesh>(m_geometry_pool,
+                                                                primitive_graphics::blanks::cube_normal_vertices,
+                                                                primitive_graphics::blanks::cube_indices,
+                                                                primitive_graphics::vertex_format_e::compact);
+
+    const auto cube = m_entities.create(std::move(mesh));
+    m_entities.set_position(cube, {0.0, 0.0, 5.0});
+
+    // a field of small props around the central cube, all of them sharing one compact mesh and moving with the
+    // field's root
+    constexpr auto field_size = 16;
+    const auto field = m_entities.create();
+    m_entities.set_position(field, {-field_size / 2.0, 1.5, 1.0});
+    for (auto x = 0; x < field_size; ++x) {
+        for (auto z = 0; z < field_size; ++z) {
+            const auto prop = m_entities.create(prop_mesh, field);
+            m_entities.set_position(prop, {x, 0.0, z});
+            m_entities.set_scale(prop, 0.2f);
+            m_entities.set_color(prop,
+                                 {static_cast<float>(x) / field_size, 0.5f, static_cast<float>(z) / field_size});
+        }
+    }
+}
+
+void Scene::load_model() {
+    const auto cache_path = model_cache_path();
+    if (is_cache_up_to_date(cache_path, model_path())) {
+        try {
+            add_model(primitive_graphics::MeshCache{cache_path});
+            return;
+        } catch (const std::exception &e) {
+            // e.g. written by an older version: it is written again from the model
+            logger()->warn("Mesh cache {} is not usable: {}", cache_path.string(), e.what());
+        }
+    }
+
+    if (!std::filesystem::exists(model_path())) {
+        logger()->info("No model at {}", model_path().string());
+        return;
+    }
+    m_model_data = primitive_graphics::load_obj_async(m_thread_pool, model_path());
+}
+
+void Scene::update_model() {
+    try {
+        // the levels of detail and the meshlets are built on a worker too, only the upload is left to this thread
+        if (is_ready(m_model_data)) {
+            m_model_cache = m_thread_pool.submit([mesh_data = m_model_data.get()]() mutable {
+                write_model_cache(std::move(mesh_data), model_cache_path());
+            });
+        }
+        if (is_ready(m_model_cache)) {
+            m_model_cache.get();
+            add_model(primitive_graphics::MeshCache{model_cache_path()});
+        }
+    } catch (const std::exception &e) {
+        logger()->error("Failed to load the model {}: {}", model_path().string(), e.what());
+    }
+}
+
+void Scene::add_model(const primitive_graphics::MeshCache &mesh_cache) {
+    auto mesh = std::make_shared<primitive_graphics::Mesh>(m_geometry_pool, mesh_cache);
+    const auto radius = mesh->bounds().radius;
+    logger()->info("Model: {} vertices, {} levels of detail, {} meshlets",
+                   mesh_cache.header().vertex_count,
+                   mesh_cache.header().lod_count,
+                   mesh_cache.header().meshlet_count);
+
+    // next to the central cube, about as large as it whatever the units of the model
+    const auto model = m_entities.create(std::move(mesh));
+    m_entities.set_position(model, {2.0, 0.0, 5.0});
+    m_entities.set_scale(model, radius > 0.0f ? 0.5f / radius : 1.0f);
+}
 
 void Scene::update_camera_state() {
     m_camera.update(m_swapchain_uptr->aspect_ratio());
@@ -3,10 +3,22 @@
 
 #pragma once
 
+#include <cstdint>
+#include <future>
+#include <limits>
 #include <memory>
+#include <optional>
+
+#include <glm/vec3.hpp>
 
 #include "cameras/camera.hpp"
+#include "primitive_graphics/mesh_cache.hpp"
+#include "primitive_graphics/mesh_data.hpp"
+#include "scene/bvh.hpp"
+#include "scene/entity_registry.hpp"
+#include "util/thread_pool.hpp"
 #include "vulkan/device.hpp"
+#include "vulkan/geometry_pool.hpp"
 #include "vulkan/swapchain.hpp"
 #include "window.hpp"
 
@@ -14,20 +26,57 @@ namespace sm::arcane::scene {
 
 class Scene {
 public:
-    explicit Scene(Window &window, const vulkan::Device &device, const std::unique_ptr<vulkan::Swapchain> &swapchain);
+    // The meshes of the scene are allocated from `geometry_pool`, and its model is loaded on `thread_pool`; both must
+    // outlive the scene
+    explicit Scene(Window &window,
+                   const vulkan::Device &device,
+                   const std::unique_ptr<vulkan::Swapchain> &swapchain,
+                   vulkan::GeometryPool &geometry_pool,
+                   util::ThreadPool &thread_pool);
 
     [[nodiscard]] cameras::Camera &camera();
+    [[nodiscard]] EntityRegistry &entities() noexcept { return m_entities; }
+    [[nodiscard]] const EntityRegistry &entities() const noexcept { return m_entities; }
+    // Of the entities having a mesh, up to date as of the last `update`. The tree is only maintained when queried, at
+    // most once per update of the registry, so the frames that don't query it don't pay for it
+    [[nodiscard]] const Bvh &bvh();
+    // the entity having a mesh the camera looks at, through `bvh`
+    [[nodiscard]] std::optional<Bvh::ray_hit_s> pick(float max_distance = std::numeric_limits<float>::max());
 
     void update();
 
 private:
+    void create_entities();
+    // Maps the mesh cache of the model when it is up to date, otherwise starts loading the model (see `model_path`) on
+    // the workers; a scene without a model keeps only its primitives
+    void load_model();
+    // creates the model's entity once its mesh cache has been written
+    void update_model();
+    void add_model(const primitive_graphics::MeshCache &mesh_cache);
     void update_camera_state();
+    void update_bvh();
+    // highlights the entity `pick` finds while the space key is held
+    void update_picking();
 
     Window &m_window;
     const vulkan::Device &m_device;
     const std::unique_ptr<vulkan::Swapchain> &m_swapchain_uptr;
+    vulkan::GeometryPool &m_geometry_pool;
+    util::ThreadPool &m_thread_pool;
 
     cameras::Camera m_camera;
+    EntityRegistry m_entities;
+    Bvh m_bvh;
+    std::uint64_t m_bvh_structure_version = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t m_bvh_version = std::numeric_limits<std::uint64_t>::max();
+
+    // the model parsed on a worker, then the writing of its mesh cache; invalid once taken
+    std::future<primitive_graphics::mesh_data_s> m_model_data;
+    std::future<void> m_model_cache;
+
+    // the highlighted entity, and its color to restore
+    entity_s m_picked_entity = g_no_entity;
+    glm::f32vec3 m_picked_color{1.0f};
 };
 
 } // namespace sm::arcane::scene
\ No newline at end of file
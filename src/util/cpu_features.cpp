@@ -0,0 +1,57 @@
+#include "cpu_features.hpp"
+
+#include <array>
+
+#include "os.h"
+
+#if SM_ARCANE_COMPILER_MSVC
+    #include <immintrin.h>
+    #include <intrin.h>
+#endif
+
+namespace sm::arcane::util {
+
+namespace {
+
+[[nodiscard]] simd_level_e detect_simd_level() noexcept {
+#if SM_ARCANE_COMPILER_MSVC
+    auto registers = std::array<int, 4>{};
+    __cpuid(registers.data(), 1);
+    const auto sse2 = (registers[3] & (1 << 26)) != 0;
+    const auto fma = (registers[2] & (1 << 12)) != 0;
+    // the OS must save the AVX registers on context switches too
+    const auto os_saves_avx = (registers[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    __cpuidex(registers.data(), 7, 0);
+    const auto avx2 = (registers[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    const auto sse2 = __builtin_cpu_supports("sse2") != 0;
+    const auto fma = __builtin_cpu_supports("fma") != 0;
+    // checks the OS support as well
+    const auto os_saves_avx = true;
+    const auto avx2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+
+    if (avx2 && fma && os_saves_avx) {
+        return simd_level_e::avx2;
+    }
+    return sse2 ? simd_level_e::sse2 : simd_level_e::scalar;
+}
+
+} // namespace
+
+simd_level_e simd_level() noexcept {
+    static const auto level = detect_simd_level();
+    return level;
+}
+
+std::string_view to_string(const simd_level_e level) noexcept {
+    switch (level) {
+        case simd_level_e::scalar: return "scalar";
+        case simd_level_e::sse2: return "SSE2";
+        case simd_level_e::avx2: return "AVX2";
+    }
+    return "unknown";
+}
+
+} // namespace sm::arcane::util
@@ -0,0 +1,18 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <string_view>
+
+namespace sm::arcane::util {
+
+// The instruction sets the SIMD kernels of the engine have a path for, each a superset of the previous one
+enum class simd_level_e { scalar, sse2, avx2 };
+
+// the widest level both the CPU and the OS support, detected on the first call; AVX2 also requires FMA
+[[nodiscard]] simd_level_e simd_level() noexcept;
+
+[[nodiscard]] std::string_view to_string(simd_level_e level) noexcept;
+
+} // namespace sm::arcane::util
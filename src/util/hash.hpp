@@ -0,0 +1,21 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+namespace sm::arcane::util {
+
+template<typename T>
+void hash_combine(std::size_t &seed, const T &value) noexcept {
+    if constexpr (std::is_enum_v<T>) {
+        hash_combine(seed, static_cast<std::underlying_type_t<T>>(value));
+    } else {
+        seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+}
+
+} // namespace sm::arcane::util
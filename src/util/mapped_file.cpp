@@ -0,0 +1,124 @@
+#include "mapped_file.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#include "os.h"
+
+#if SM_ARCANE_OPERATING_SYSTEM_WINDOWS
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace sm::arcane::util {
+
+namespace {
+
+[[noreturn]] void throw_mapping_error(const std::filesystem::path &path) {
+    throw std::runtime_error{"Failed to map the file " + path.string() + " into memory"};
+}
+
+} // namespace
+
+#if SM_ARCANE_OPERATING_SYSTEM_WINDOWS
+
+MappedFile::MappedFile(const std::filesystem::path &path) {
+    const auto file = CreateFileW(path.c_str(),
+                                  GENERIC_READ,
+                                  FILE_SHARE_READ,
+                                  nullptr,
+                                  OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                  nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw_mapping_error(path);
+    }
+
+    auto size = LARGE_INTEGER{};
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        throw_mapping_error(path);
+    }
+    m_size = static_cast<std::size_t>(size.QuadPart);
+    if (m_size == 0) {
+        CloseHandle(file);
+        return;
+    }
+
+    // the view keeps the mapping object, and the mapping object the file, alive
+    const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        throw_mapping_error(path);
+    }
+    m_data = static_cast<const std::byte *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    CloseHandle(mapping);
+    if (m_data == nullptr) {
+        throw_mapping_error(path);
+    }
+}
+
+void MappedFile::unmap() noexcept {
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path &path) {
+    const auto file = open(path.c_str(), O_RDONLY);
+    if (file == -1) {
+        throw_mapping_error(path);
+    }
+
+    struct stat file_stat = {};
+    if (fstat(file, &file_stat) == -1) {
+        close(file);
+        throw_mapping_error(path);
+    }
+    m_size = static_cast<std::size_t>(file_stat.st_size);
+    if (m_size == 0) {
+        close(file);
+        return;
+    }
+
+    // the mapping stays valid after the descriptor is closed
+    auto *const data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (data == MAP_FAILED) {
+        throw_mapping_error(path);
+    }
+    // the file is read front to back: blobs are copied out in order
+    madvise(data, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const std::byte *>(data);
+}
+
+void MappedFile::unmap() noexcept {
+    if (m_data) {
+        munmap(const_cast<std::byte *>(m_data), m_size);
+    }
+}
+
+#endif
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : m_data{std::exchange(other.m_data, nullptr)},
+      m_size{std::exchange(other.m_size, 0)} {}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        unmap();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() { unmap(); }
+
+} // namespace sm::arcane::util
@@ -0,0 +1,35 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace sm::arcane::util {
+
+// A whole file mapped read-only into the address space: pages are brought in by the OS as they are touched, so the
+// contents can be read (e.g. copied into staging memory) without reading the file into an intermediate buffer first.
+// The mapping starts at a page boundary. Throws `std::runtime_error` when the file can't be opened or mapped
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path &path);
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    ~MappedFile();
+
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept { return {m_data, m_size}; }
+
+private:
+    void unmap() noexcept;
+
+    const std::byte *m_data = nullptr;
+    std::size_t m_size = 0;
+};
+
+} // namespace sm::arcane::util
@@ -0,0 +1,68 @@
+#include "range_allocator.hpp"
+
+#include <cassert>
+#include <iterator>
+
+namespace sm::arcane::util {
+
+RangeAllocator::RangeAllocator(const std::uint64_t capacity) : m_capacity{capacity}, m_free_size{capacity} {
+    if (capacity > 0) {
+        m_free_ranges.emplace(0, capacity);
+    }
+}
+
+std::optional<RangeAllocator::range_s> RangeAllocator::allocate(const std::uint64_t size,
+                                                                const std::uint64_t alignment) {
+    assert(size > 0 && alignment > 0);
+
+    for (auto it = m_free_ranges.begin(); it != m_free_ranges.end(); ++it) {
+        const auto [free_offset, free_size] = *it;
+        const auto offset = (free_offset + alignment - 1) / alignment * alignment;
+        if (offset + size > free_offset + free_size) {
+            continue;
+        }
+
+        // what is left on either side of the allocation stays free
+        m_free_ranges.erase(it);
+        if (offset > free_offset) {
+            m_free_ranges.emplace(free_offset, offset - free_offset);
+        }
+        if (offset + size < free_offset + free_size) {
+            m_free_ranges.emplace(offset + size, free_offset + free_size - (offset + size));
+        }
+
+        m_free_size -= size;
+        return range_s{.offset = offset, .size = size};
+    }
+    return std::nullopt;
+}
+
+void RangeAllocator::free(const range_s &range) {
+    assert(range.size > 0 && range.offset + range.size <= m_capacity);
+
+    auto offset = range.offset;
+    auto size = range.size;
+
+    const auto next = m_free_ranges.lower_bound(offset);
+    assert((next == m_free_ranges.end() || offset + size <= next->first) && "The range is already free");
+    if (next != m_free_ranges.end() && next->first == offset + size) {
+        size += next->second;
+        m_free_ranges.erase(next);
+    }
+
+    const auto after = m_free_ranges.lower_bound(offset);
+    if (after != m_free_ranges.begin()) {
+        const auto previous = std::prev(after);
+        assert(previous->first + previous->second <= offset && "The range is already free");
+        if (previous->first + previous->second == offset) {
+            offset = previous->first;
+            size += previous->second;
+            m_free_ranges.erase(previous);
+        }
+    }
+
+    m_free_ranges.emplace(offset, size);
+    m_free_size += range.size;
+}
+
+} // namespace sm::arcane::util
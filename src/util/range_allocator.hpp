@@ -0,0 +1,41 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+
+namespace sm::arcane::util {
+
+// Hands out sub-ranges of [0, capacity) in any unit (bytes, elements). First fit over an offset-ordered free list;
+// freed ranges are merged with their free neighbours, so unloading and reloading data of varying sizes doesn't split
+// the space into ever smaller pieces. Owns no memory: the ranges are meant to index a buffer owned elsewhere
+class RangeAllocator {
+public:
+    struct range_s {
+        std::uint64_t offset = 0;
+        std::uint64_t size = 0;
+    };
+
+    explicit RangeAllocator(std::uint64_t capacity);
+
+    [[nodiscard]] std::uint64_t capacity() const noexcept { return m_capacity; }
+    [[nodiscard]] std::uint64_t free_size() const noexcept { return m_free_size; }
+
+    // `alignment` applies to the offset and doesn't have to be a power of two (e.g. a vertex stride); empty when no
+    // free range is large enough
+    [[nodiscard]] std::optional<range_s> allocate(std::uint64_t size, std::uint64_t alignment = 1);
+
+    void free(const range_s &range);
+
+private:
+    std::uint64_t m_capacity;
+    std::uint64_t m_free_size;
+
+    // offset -> size of every free range; no two of them are adjacent
+    std::map<std::uint64_t, std::uint64_t> m_free_ranges;
+};
+
+} // namespace sm::arcane::util
@@ -0,0 +1,59 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+namespace sm::arcane::util {
+
+ThreadPool::ThreadPool(std::size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    }
+
+    m_workers.reserve(thread_count);
+    for (auto i = std::size_t{0}; i < thread_count; ++i) {
+        m_workers.emplace_back([this] { work(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        const auto lock = std::scoped_lock{m_mutex};
+        m_is_stopping = true;
+    }
+    m_condition.notify_all();
+    m_workers.clear();
+}
+
+void ThreadPool::enqueue(std::function<void()> &&task) {
+    {
+        const auto lock = std::scoped_lock{m_mutex};
+        m_tasks.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+}
+
+void ThreadPool::enqueue_front(std::function<void()> &&task) {
+    {
+        const auto lock = std::scoped_lock{m_mutex};
+        m_tasks.push_front(std::move(task));
+    }
+    m_condition.notify_one();
+}
+
+void ThreadPool::work() {
+    while (true) {
+        auto task = std::function<void()>{};
+        {
+            auto lock = std::unique_lock{m_mutex};
+            m_condition.wait(lock, [this] { return m_is_stopping || !m_tasks.empty(); });
+            if (m_tasks.empty()) {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+} // namespace sm::arcane::util
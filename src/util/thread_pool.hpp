@@ -0,0 +1,123 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sm::arcane::util {
+
+// A fixed set of worker threads consuming one FIFO task queue, which the batches of `parallel_for` skip. Meant for
+// coarse-grained engine jobs (pipeline compilation, asset loading, culling batches), not for fine-grained work stealing
+class ThreadPool {
+public:
+    // 0 means "one worker per hardware thread except the calling one"
+    explicit ThreadPool(std::size_t thread_count = 0);
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+    ThreadPool(ThreadPool &&) noexcept = delete;
+    ThreadPool &operator=(ThreadPool &&) noexcept = delete;
+
+    // drains the queue: every task submitted so far is executed before the workers are joined
+    ~ThreadPool();
+
+    [[nodiscard]] std::size_t thread_count() const noexcept { return m_workers.size(); }
+
+    template<typename F>
+    [[nodiscard]] std::future<std::invoke_result_t<F>> submit(F &&task) {
+        // `std::function` requires a copyable callable, hence the shared state
+        auto packaged_task = std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::forward<F>(task));
+        auto future = packaged_task->get_future();
+        enqueue([packaged_task = std::move(packaged_task)] { (*packaged_task)(); });
+        return future;
+    }
+
+    // runs `task(i)` for every i in [0, count), split into one batch per worker plus one for the calling thread, which
+    // takes part in the work instead of idling; rethrows the first exception once every batch is done. The batches
+    // are per-frame work, so they go ahead of the queued tasks, and the calling thread also runs the batches that no
+    // worker has started, so that long tasks occupying the workers (e.g. asset loading) don't stall it. Must not be
+    // called from a task of the same pool: the nested batches could wait for workers all blocked in the outer call
+    template<typename F>
+    void parallel_for(const std::size_t count, F &&task) {
+        const auto batch_count = std::min(count, thread_count() + 1);
+        if (batch_count <= 1) {
+            for (auto i = std::size_t{0}; i < count; ++i) {
+                task(i);
+            }
+            return;
+        }
+
+        const auto run_batch = [&task, count, batch_count](const std::size_t batch) {
+            for (auto i = count * batch / batch_count; i < count * (batch + 1) / batch_count; ++i) {
+                task(i);
+            }
+        };
+
+        // copied into the helper tasks, which may only start after the call has returned: those find no batch left
+        // and never touch `run_batch`
+        const auto state = std::make_shared<parallel_for_state_s>();
+        const auto run_batches = [&run_batch, batch_count](parallel_for_state_s &batches) {
+            for (auto batch = batches.next_batch++; batch < batch_count; batch = batches.next_batch++) {
+                try {
+                    run_batch(batch);
+                } catch (...) {
+                    const auto lock = std::scoped_lock{batches.mutex};
+                    if (!batches.first_exception) {
+                        batches.first_exception = std::current_exception();
+                    }
+                }
+                if (++batches.done_batches == batch_count) {
+                    batches.done_batches.notify_all();
+                }
+            }
+        };
+        for (auto batch = std::size_t{1}; batch < batch_count; ++batch) {
+            enqueue_front([state, run_batches] { run_batches(*state); });
+        }
+        run_batches(*state);
+
+        // a batch claimed by a worker refers to `run_batch` and `task`, so every one must finish before returning
+        for (auto done = state->done_batches.load(); done < batch_count; done = state->done_batches.load()) {
+            state->done_batches.wait(done);
+        }
+        if (state->first_exception) {
+            std::rethrow_exception(state->first_exception);
+        }
+    }
+
+private:
+    struct parallel_for_state_s {
+        std::atomic<std::size_t> next_batch = 0;
+        std::atomic<std::size_t> done_batches = 0;
+        std::mutex mutex;
+        std::exception_ptr first_exception;
+    };
+
+    void enqueue(std::function<void()> &&task);
+    void enqueue_front(std::function<void()> &&task);
+    void work();
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<std::function<void()>> m_tasks;
+    bool m_is_stopping = false;
+
+    // declared last: the workers use the members above, so they must be joined before those are destroyed
+    std::vector<std::jthread> m_workers;
+};
+
+} // namespace sm::arcane::util
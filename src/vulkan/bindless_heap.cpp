@@ -0,0 +1,178 @@
+#include "bindless_heap.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <stdexcept>
+
+namespace sm::arcane::vulkan {
+
+namespace {
+
+inline constexpr auto g_storage_buffer_binding = 0u;
+inline constexpr auto g_sampled_image_binding = 1u;
+
+inline constexpr auto g_bindless_stages = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment |
+                                          vk::ShaderStageFlagBits::eCompute;
+
+struct capacities_s {
+    std::uint32_t storage_buffers;
+    std::uint32_t sampled_images;
+};
+
+[[nodiscard]] capacities_s pick_capacities(const vk::raii::PhysicalDevice &physical_device) {
+    const auto properties = physical_device.getProperties2<vk::PhysicalDeviceProperties2,
+                                                           vk::PhysicalDeviceDescriptorIndexingProperties>();
+    const auto &limits = properties.get<vk::PhysicalDeviceDescriptorIndexingProperties>();
+
+    // both arrays are visible to every bindless stage, so the per-stage resource limit is shared between them
+    const auto per_stage_resources = limits.maxPerStageUpdateAfterBindResources;
+    const auto storage_buffers = std::min({g_max_bindless_storage_buffers,
+                                           limits.maxDescriptorSetUpdateAfterBindStorageBuffers,
+                                           limits.maxPerStageDescriptorUpdateAfterBindStorageBuffers,
+                                           per_stage_resources / 2});
+    const auto sampled_images = std::min({g_max_bindless_sampled_images,
+                                          limits.maxDescriptorSetUpdateAfterBindSampledImages,
+                                          limits.maxDescriptorSetUpdateAfterBindSamplers,
+                                          limits.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                                          limits.maxPerStageDescriptorUpdateAfterBindSamplers,
+                                          per_stage_resources / 2});
+
+    return {.storage_buffers = storage_buffers, .sampled_images = sampled_images};
+}
+
+[[nodiscard]] vk::raii::DescriptorSetLayout create_layout(const vk::raii::Device &device,
+                                                          const capacities_s capacities) {
+    const auto bindings = std::array{vk::DescriptorSetLayoutBinding{g_storage_buffer_binding,
+                                                                    vk::DescriptorType::eStorageBuffer,
+                                                                    capacities.storage_buffers,
+                                                                    g_bindless_stages},
+                                     vk::DescriptorSetLayoutBinding{g_sampled_image_binding,
+                                                                    vk::DescriptorType::eCombinedImageSampler,
+                                                                    capacities.sampled_images,
+                                                                    g_bindless_stages}};
+
+    constexpr auto binding_flags = vk::DescriptorBindingFlagBits::eUpdateAfterBind |
+                                   vk::DescriptorBindingFlagBits::eUpdateUnusedWhilePending |
+                                   vk::DescriptorBindingFlagBits::ePartiallyBound;
+    const auto bindings_flags = std::array{vk::DescriptorBindingFlags{binding_flags},
+                                           vk::DescriptorBindingFlags{binding_flags}};
+    const auto binding_flags_info = vk::DescriptorSetLayoutBindingFlagsCreateInfo{bindings_flags};
+
+    return {device,
+            vk::DescriptorSetLayoutCreateInfo{vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool,
+                                              bindings,
+                                              &binding_flags_info}};
+}
+
+[[nodiscard]] vk::raii::DescriptorPool create_pool(const vk::raii::Device &device, const capacities_s capacities) {
+    const auto pool_sizes = std::array{
+            vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer, capacities.storage_buffers},
+            vk::DescriptorPoolSize{vk::DescriptorType::eCombinedImageSampler, capacities.sampled_images}};
+
+    return {device, vk::DescriptorPoolCreateInfo{vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind, 1, pool_sizes}};
+}
+
+} // namespace
+
+bindless_id_t BindlessHeap::id_allocator_s::acquire(const FrameScheduler &frame_scheduler) {
+    if (!released_ids.empty()) {
+        const auto completed_frame = frame_scheduler.completed_frame();
+        while (!released_ids.empty() && released_ids.front().first <= completed_frame) {
+            free_ids.push_back(released_ids.front().second);
+            released_ids.pop_front();
+        }
+    }
+
+    if (!free_ids.empty()) {
+        const auto id = free_ids.back();
+        free_ids.pop_back();
+        return id;
+    }
+
+    if (next == capacity) {
+        throw std::runtime_error{"BindlessHeap is out of descriptor slots"};
+    }
+    return next++;
+}
+
+BindlessHeap::BindlessHeap(Device &device)
+    : m_device{device},
+      m_layout{nullptr},
+      m_pool{nullptr} {
+    const auto capacities = pick_capacities(m_device.physical_device());
+    m_storage_buffers.capacity = capacities.storage_buffers;
+    m_sampled_images.capacity = capacities.sampled_images;
+
+    m_layout = create_layout(m_device.device(), capacities);
+    m_pool = create_pool(m_device.device(), capacities);
+
+    // the set lives as long as the pool, so the RAII wrapper must not own it
+    m_set = m_device.device()
+                    .allocateDescriptorSets(vk::DescriptorSetAllocateInfo{*m_pool, *m_layout})
+                    .front()
+                    .release();
+}
+
+bindless_id_t BindlessHeap::register_storage_buffer(const vk::Buffer buffer,
+                                                    const vk::DeviceSize offset,
+                                                    const vk::DeviceSize range) {
+    const auto id = m_storage_buffers.acquire(m_device.frame_scheduler());
+    update_storage_buffer(id, buffer, offset, range);
+    return id;
+}
+
+bindless_id_t BindlessHeap::register_sampled_image(const vk::ImageView image_view,
+                                                   const vk::Sampler sampler,
+                                                   const vk::ImageLayout image_layout) {
+    const auto id = m_sampled_images.acquire(m_device.frame_scheduler());
+    update_sampled_image(id, image_view, sampler, image_layout);
+    return id;
+}
+
+void BindlessHeap::update_storage_buffer(const bindless_id_t id,
+                                         const vk::Buffer buffer,
+                                         const vk::DeviceSize offset,
+                                         const vk::DeviceSize range) const {
+    assert(id < m_storage_buffers.next);
+
+    const auto buffer_info = vk::DescriptorBufferInfo{buffer, offset, range};
+    const auto write = vk::WriteDescriptorSet{m_set,
+                                              g_storage_buffer_binding,
+                                              id,
+                                              1,
+                                              vk::DescriptorType::eStorageBuffer,
+                                              nullptr,
+                                              &buffer_info};
+    m_device.device().updateDescriptorSets(write, nullptr);
+}
+
+void BindlessHeap::update_sampled_image(const bindless_id_t id,
+                                        const vk::ImageView image_view,
+                                        const vk::Sampler sampler,
+                                        const vk::ImageLayout image_layout) const {
+    assert(id < m_sampled_images.next);
+
+    const auto image_info = vk::DescriptorImageInfo{sampler, image_view, image_layout};
+    const auto write = vk::WriteDescriptorSet{m_set,
+                                              g_sampled_image_binding,
+                                              id,
+                                              1,
+                                              vk::DescriptorType::eCombinedImageSampler,
+                                              &image_info};
+    m_device.device().updateDescriptorSets(write, nullptr);
+}
+
+void BindlessHeap::release_storage_buffer(const bindless_id_t id) { release(m_storage_buffers, id); }
+
+void BindlessHeap::release_sampled_image(const bindless_id_t id) { release(m_sampled_images, id); }
+
+void BindlessHeap::release(id_allocator_s &ids, const bindless_id_t id) {
+    assert(id < ids.next);
+
+    // the frames recorded so far may still index the slot, so it is handed out again only once they are completed.
+    // The heap keeps the pending ids itself: a callback deferred to the device could outlive the heap
+    ids.released_ids.emplace_back(m_device.frame_scheduler().current_frame(), id);
+}
+
+} // namespace sm::arcane::vulkan
@@ -0,0 +1,95 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "vulkan/device.hpp"
+
+namespace sm::arcane::vulkan {
+
+using bindless_id_t = std::uint32_t;
+
+inline constexpr auto g_invalid_bindless_id = std::numeric_limits<bindless_id_t>::max();
+
+// upper bounds of the heap arrays; the actual sizes are clamped to the update-after-bind limits of the device
+inline constexpr auto g_max_bindless_storage_buffers = 1u << 16;
+inline constexpr auto g_max_bindless_sampled_images = 1u << 14;
+
+// The engine-wide bindless descriptor set (set 1 of every pipeline, see `common/shaders/bindless.glsl`):
+//  - binding 0 is a runtime array of storage buffers, binding 1 is a runtime array of combined image samplers;
+//  - resources are registered once and addressed by the returned id from shaders (push constants, instance data), so
+//    drawing never needs to bind another descriptor set;
+//  - the bindings are update-after-bind and partially bound: slots are written while the set is bound by frames in
+//    flight and unused slots may stay empty. A released id is recycled only once the frames that could still index it
+//    are completed
+class BindlessHeap {
+public:
+    explicit BindlessHeap(Device &device);
+
+    BindlessHeap(const BindlessHeap &) = delete;
+    BindlessHeap &operator=(const BindlessHeap &) = delete;
+    BindlessHeap(BindlessHeap &&) noexcept = delete;
+    BindlessHeap &operator=(BindlessHeap &&) noexcept = delete;
+
+    ~BindlessHeap() = default;
+
+    [[nodiscard]] vk::DescriptorSetLayout layout() const noexcept { return *m_layout; }
+    [[nodiscard]] vk::DescriptorSet set() const noexcept { return m_set; }
+
+    [[nodiscard]] std::uint32_t storage_buffer_capacity() const noexcept { return m_storage_buffers.capacity; }
+    [[nodiscard]] std::uint32_t sampled_image_capacity() const noexcept { return m_sampled_images.capacity; }
+
+    [[nodiscard]] bindless_id_t register_storage_buffer(vk::Buffer buffer,
+                                                        vk::DeviceSize offset = 0,
+                                                        vk::DeviceSize range = vk::WholeSize);
+    [[nodiscard]] bindless_id_t register_sampled_image(
+            vk::ImageView image_view,
+            vk::Sampler sampler,
+            vk::ImageLayout image_layout = vk::ImageLayout::eShaderReadOnlyOptimal);
+
+    // re-points an existing id, e.g. after the resource behind it has been recreated
+    void update_storage_buffer(bindless_id_t id,
+                               vk::Buffer buffer,
+                               vk::DeviceSize offset = 0,
+                               vk::DeviceSize range = vk::WholeSize) const;
+    void update_sampled_image(bindless_id_t id,
+                              vk::ImageView image_view,
+                              vk::Sampler sampler,
+                              vk::ImageLayout image_layout = vk::ImageLayout::eShaderReadOnlyOptimal) const;
+
+    void release_storage_buffer(bindless_id_t id);
+    void release_sampled_image(bindless_id_t id);
+
+private:
+    struct id_allocator_s {
+        std::uint32_t capacity = 0;
+        std::uint32_t next = 0;
+        std::vector<bindless_id_t> free_ids;
+        // each with the frame that has to be completed before the id is handed out again
+        std::deque<std::pair<std::uint64_t, bindless_id_t>> released_ids;
+
+        [[nodiscard]] bindless_id_t acquire(const FrameScheduler &frame_scheduler);
+    };
+
+    void release(id_allocator_s &ids, bindless_id_t id);
+
+    Device &m_device;
+
+    id_allocator_s m_storage_buffers;
+    id_allocator_s m_sampled_images;
+
+    vk::raii::DescriptorSetLayout m_layout;
+    vk::raii::DescriptorPool m_pool;
+    // freed together with the pool
+    vk::DescriptorSet m_set;
+};
+
+} // namespace sm::arcane::vulkan
@@ -21,12 +21,16 @@ namespace {
 } // namespace
 
 [[nodiscard]] config_s config_from_json(const json::value &desc) {
+    const auto *frames_in_flight_desc = desc.as_object().if_contains("frames_in_flight");
     return {.enable_validation_layers = json::value_to<bool>(desc.at("enable_validation_layers")),
-            .device = device_config_from_json(desc.at("device"))};
+            .device = device_config_from_json(desc.at("device")),
+            .frames_in_flight = frames_in_flight_desc ? json::value_to<std::uint32_t>(*frames_in_flight_desc)
+                                                      : g_default_frames_in_flight};
 }
 [[nodiscard]] json::value config_to_json(const config_s &config) {
     return {{"enable_validation_layers", config.enable_validation_layers},
-            {"device", device_config_to_json(config.device)}};
+            {"device", device_config_to_json(config.device)},
+            {"frames_in_flight", config.frames_in_flight}};
 }
 
 } // namespace sm::arcane::vulkan
\ No newline at end of file
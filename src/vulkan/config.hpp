@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -18,11 +19,14 @@ struct device_config_s {
     BOOST_DESCRIBE_STRUCT(device_config_s, (), (enable_anisotropy, max_anisotropy))
 };
 
+inline constexpr auto g_default_frames_in_flight = 2u;
+
 struct config_s {
     bool enable_validation_layers;
     device_config_s device;
+    std::uint32_t frames_in_flight = g_default_frames_in_flight; // optional in the JSON config
 
-    BOOST_DESCRIBE_STRUCT(config_s, (), (enable_validation_layers, device))
+    BOOST_DESCRIBE_STRUCT(config_s, (), (enable_validation_layers, device, frames_in_flight))
 };
 
 [[nodiscard]] config_s config_from_json(const boost::json::value & /* desc */);
@@ -0,0 +1,139 @@
+#include "descriptor_cache.hpp"
+
+#include <array>
+#include <utility>
+
+#include "util/hash.hpp"
+
+namespace sm::arcane::vulkan {
+
+namespace {
+
+inline constexpr auto g_sets_per_pool = 64u;
+
+// descriptors per set a pool is sized for, by type
+inline constexpr auto g_pool_size_ratios = std::array{std::pair{vk::DescriptorType::eUniformBuffer, 1u},
+                                                      std::pair{vk::DescriptorType::eUniformBufferDynamic, 1u},
+                                                      std::pair{vk::DescriptorType::eStorageBuffer, 2u},
+                                                      std::pair{vk::DescriptorType::eStorageBufferDynamic, 1u},
+                                                      std::pair{vk::DescriptorType::eCombinedImageSampler, 2u},
+                                                      std::pair{vk::DescriptorType::eSampledImage, 1u},
+                                                      std::pair{vk::DescriptorType::eStorageImage, 1u}};
+
+[[nodiscard]] vk::raii::DescriptorPool create_descriptor_pool(const vk::raii::Device &device) {
+    auto pool_sizes = std::array<vk::DescriptorPoolSize, g_pool_size_ratios.size()>{};
+    for (auto i = std::size_t{0}; i < g_pool_size_ratios.size(); ++i) {
+        pool_sizes[i] = vk::DescriptorPoolSize{g_pool_size_ratios[i].first,
+                                               g_pool_size_ratios[i].second * g_sets_per_pool};
+    }
+    return {device, vk::DescriptorPoolCreateInfo{{}, g_sets_per_pool, pool_sizes}};
+}
+
+} // namespace
+
+DescriptorWriter &DescriptorWriter::write_buffer(const std::uint32_t binding,
+                                                 const vk::DescriptorType type,
+                                                 const vk::Buffer buffer,
+                                                 const vk::DeviceSize offset,
+                                                 const vk::DeviceSize range) {
+    m_writes.push_back({binding, type, m_buffer_infos.size(), false});
+    m_buffer_infos.emplace_back(buffer, offset, range);
+    return *this;
+}
+
+DescriptorWriter &DescriptorWriter::write_image(const std::uint32_t binding,
+                                                const vk::DescriptorType type,
+                                                const vk::ImageView image_view,
+                                                const vk::Sampler sampler,
+                                                const vk::ImageLayout image_layout) {
+    m_writes.push_back({binding, type, m_image_infos.size(), true});
+    m_image_infos.emplace_back(sampler, image_view, image_layout);
+    return *this;
+}
+
+void DescriptorWriter::update(const vk::raii::Device &device, const vk::DescriptorSet descriptor_set) {
+    // the infos are referenced by pointer, so the writes are built only once both vectors are final
+    auto write_descriptor_sets = std::vector<vk::WriteDescriptorSet>{};
+    write_descriptor_sets.reserve(m_writes.size());
+    for (const auto &write : m_writes) {
+        write_descriptor_sets.emplace_back(descriptor_set,
+                                           write.binding,
+                                           0,
+                                           1,
+                                           write.type,
+                                           write.is_image ? &m_image_infos[write.info_index] : nullptr,
+                                           write.is_image ? nullptr : &m_buffer_infos[write.info_index]);
+    }
+    device.updateDescriptorSets(write_descriptor_sets, nullptr);
+
+    m_writes.clear();
+    m_buffer_infos.clear();
+    m_image_infos.clear();
+}
+
+std::size_t DescriptorCache::layout_key_hash_s::operator()(const layout_key_s &key) const noexcept {
+    auto seed = std::hash<VkDescriptorSetLayoutCreateFlags>{}(static_cast<VkDescriptorSetLayoutCreateFlags>(key.flags));
+    for (const auto &binding : key.bindings) {
+        util::hash_combine(seed, binding.binding);
+        util::hash_combine(seed, static_cast<VkDescriptorType>(binding.descriptorType));
+        util::hash_combine(seed, binding.descriptorCount);
+        util::hash_combine(seed, static_cast<VkShaderStageFlags>(binding.stageFlags));
+        util::hash_combine(seed, static_cast<const void *>(binding.pImmutableSamplers));
+    }
+    return seed;
+}
+
+DescriptorCache::DescriptorCache(const vk::raii::Device &device) : m_device{device} {
+    m_pools.push_back(create_descriptor_pool(m_device));
+}
+
+vk::DescriptorSetLayout DescriptorCache::layout(const std::span<const vk::DescriptorSetLayoutBinding> bindings,
+                                                const vk::DescriptorSetLayoutCreateFlags flags) {
+    auto key = layout_key_s{{bindings.begin(), bindings.end()}, flags};
+    if (const auto it = m_layouts.find(key); it != m_layouts.end()) {
+        return *it->second;
+    }
+
+    auto layout = vk::raii::DescriptorSetLayout{m_device, vk::DescriptorSetLayoutCreateInfo{flags, key.bindings}};
+    const auto handle = *layout;
+    m_layouts.emplace(std::move(key), std::move(layout));
+    return handle;
+}
+
+vk::DescriptorSet DescriptorCache::create_set(const vk::DescriptorSetLayout layout, writer_t &&writer) {
+    const auto &set = m_sets.emplace_back(allocate(layout), std::move(writer));
+    write(set);
+    return set.handle;
+}
+
+void DescriptorCache::refresh() {
+    for (const auto &set : m_sets) {
+        write(set);
+    }
+}
+
+vk::DescriptorSet DescriptorCache::allocate(const vk::DescriptorSetLayout layout) {
+    const auto try_allocate = [&]() -> vk::DescriptorSet {
+        // the sets are freed together with their pool, so the RAII wrapper must not own them
+        return m_device.allocateDescriptorSets(vk::DescriptorSetAllocateInfo{*m_pools.back(), layout})
+                .front()
+                .release();
+    };
+
+    try {
+        return try_allocate();
+    } catch (const vk::OutOfPoolMemoryError &) {
+    } catch (const vk::FragmentedPoolError &) {
+    }
+
+    m_pools.push_back(create_descriptor_pool(m_device));
+    return try_allocate();
+}
+
+void DescriptorCache::write(const written_set_s &set) const {
+    auto writer = DescriptorWriter{};
+    set.writer(writer);
+    writer.update(m_device, set.handle);
+}
+
+} // namespace sm::arcane::vulkan
\ No newline at end of file
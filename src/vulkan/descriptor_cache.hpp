@@ -0,0 +1,103 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <vulkan/vulkan_raii.hpp>
+
+namespace sm::arcane::vulkan {
+
+// Collects the writes of one descriptor set and applies them in a single `vkUpdateDescriptorSets`
+class DescriptorWriter {
+public:
+    DescriptorWriter &write_buffer(std::uint32_t binding,
+                                   vk::DescriptorType type,
+                                   vk::Buffer buffer,
+                                   vk::DeviceSize offset,
+                                   vk::DeviceSize range);
+
+    DescriptorWriter &write_image(std::uint32_t binding,
+                                  vk::DescriptorType type,
+                                  vk::ImageView image_view,
+                                  vk::Sampler sampler,
+                                  vk::ImageLayout image_layout);
+
+    void update(const vk::raii::Device &device, vk::DescriptorSet descriptor_set);
+
+private:
+    struct write_s {
+        std::uint32_t binding;
+        vk::DescriptorType type;
+        std::size_t info_index;
+        bool is_image;
+    };
+
+    std::vector<vk::DescriptorBufferInfo> m_buffer_infos;
+    std::vector<vk::DescriptorImageInfo> m_image_infos;
+    std::vector<write_s> m_writes;
+};
+
+// Owns every descriptor set layout, pool and long-lived set of the renderer:
+//  - layouts are deduplicated by their bindings, so pipelines asking for the same interface share one layout;
+//  - sets come from a growable list of pools, a new pool is added when the current one runs out;
+//  - a set is written once at creation by its writer callback, and the callback is re-run only by `refresh` when the
+//    resources it refers to are recreated (e.g. after the swapchain recreation), never per frame
+class DescriptorCache {
+public:
+    using writer_t = std::function<void(DescriptorWriter &)>;
+
+    explicit DescriptorCache(const vk::raii::Device &device);
+
+    DescriptorCache(const DescriptorCache &) = delete;
+    DescriptorCache &operator=(const DescriptorCache &) = delete;
+    DescriptorCache(DescriptorCache &&) noexcept = delete;
+    DescriptorCache &operator=(DescriptorCache &&) noexcept = delete;
+
+    ~DescriptorCache() = default;
+
+    [[nodiscard]] vk::DescriptorSetLayout layout(std::span<const vk::DescriptorSetLayoutBinding> bindings,
+                                                 vk::DescriptorSetLayoutCreateFlags flags = {});
+
+    // allocates a set of `layout` and writes it with `writer`; the writer is kept for `refresh`
+    [[nodiscard]] vk::DescriptorSet create_set(vk::DescriptorSetLayout layout, writer_t &&writer);
+
+    // re-writes every set created so far; the sets must not be in use by the GPU
+    void refresh();
+
+private:
+    struct layout_key_s {
+        std::vector<vk::DescriptorSetLayoutBinding> bindings;
+        vk::DescriptorSetLayoutCreateFlags flags;
+
+        [[nodiscard]] bool operator==(const layout_key_s &other) const noexcept = default;
+    };
+
+    struct layout_key_hash_s {
+        [[nodiscard]] std::size_t operator()(const layout_key_s &key) const noexcept;
+    };
+
+    struct written_set_s {
+        vk::DescriptorSet handle;
+        writer_t writer;
+    };
+
+    [[nodiscard]] vk::DescriptorSet allocate(vk::DescriptorSetLayout layout);
+    void write(const written_set_s &set) const;
+
+    const vk::raii::Device &m_device;
+
+    std::unordered_map<layout_key_s, vk::raii::DescriptorSetLayout, layout_key_hash_s> m_layouts;
+    // the last pool is the one sets are allocated from
+    std::vector<vk::raii::DescriptorPool> m_pools;
+    std::deque<written_set_s> m_sets;
+};
+
+} // namespace sm::arcane::vulkan
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <iterator>
 #include <limits>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -77,6 +78,21 @@ void log_info_about_physical_device(const vk::raii::PhysicalDevice &physical_dev
 
 } // namespace detail
 
+[[nodiscard]] std::optional<std::uint32_t> find_dedicated_transfer_queue_family_index(
+        const std::vector<vk::QueueFamilyProperties> &queue_family_properties) noexcept {
+    // prefer a pure DMA family (no graphics and no compute), then any family with transfer but without graphics
+    for (const auto excluded_flags : {vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute,
+                                      vk::QueueFlags{vk::QueueFlagBits::eGraphics}}) {
+        for (auto i = std::size_t{0}; i < queue_family_properties.size(); ++i) {
+            const auto flags = queue_family_properties[i].queueFlags;
+            if ((flags & vk::QueueFlagBits::eTransfer) && !(flags & excluded_flags)) {
+                return static_cast<std::uint32_t>(i);
+            }
+        }
+    }
+    return std::nullopt;
+}
+
 [[nodiscard]] std::pair<std::uint32_t, std::uint32_t> find_graphics_and_present_family_indices(
         const vk::raii::PhysicalDevice &physical_device,
         const vk::SurfaceKHR surface) {
@@ -110,12 +126,26 @@ void log_info_about_physical_device(const vk::raii::PhysicalDevice &physical_dev
 }
 
 
+struct queue_family_indices_s {
+    std::uint32_t graphics;
+    std::uint32_t present;
+    std::uint32_t transfer;
+};
+
+[[nodiscard]] queue_family_indices_s find_queue_family_indices(const vk::raii::PhysicalDevice &physical_device,
+                                                               const vk::SurfaceKHR surface) {
+    const auto [graphics_index, present_index] = find_graphics_and_present_family_indices(physical_device, surface);
+    const auto transfer_index = find_dedicated_transfer_queue_family_index(physical_device.getQueueFamilyProperties());
+    return {graphics_index, present_index, transfer_index.value_or(graphics_index)};
+}
+
 [[nodiscard]] device_queue_families_s find_queue_families(const vk::raii::Device &device,
                                                           const vk::raii::PhysicalDevice &physical_device,
                                                           const vk::SurfaceKHR surface) {
-    const auto [graphics_index, present_index] = find_graphics_and_present_family_indices(physical_device, surface);
-    return {.graphics = {.index = graphics_index, .queue = {device, graphics_index, 0}},
-            .present = {.index = present_index, .queue = {device, present_index, 0}}};
+    const auto indices = find_queue_family_indices(physical_device, surface);
+    return {.graphics = {.index = indices.graphics, .queue = {device, indices.graphics, 0}},
+            .present = {.index = indices.present, .queue = {device, indices.present, 0}},
+            .transfer = {.index = indices.transfer, .queue = {device, indices.transfer, 0}}};
 }
 
 [[nodiscard]] vk::raii::PhysicalDevice pick_physical_device(const vk::raii::Instance &instance) {
@@ -132,28 +162,56 @@ void log_info_about_physical_device(const vk::raii::PhysicalDevice &physical_dev
 [[nodiscard]] vk::raii::Device create_logical_device(
         // TODO: to support config for `(1) Note`. It is necessary to make a branch to select the necessary features
         /*const config_s &config*/
-        const vk::raii::PhysicalDevice &physical_device) {
+        const vk::raii::PhysicalDevice &physical_device,
+        const vk::SurfaceKHR surface) {
     auto supported_features = physical_device.getFeatures2<vk::PhysicalDeviceFeatures2,
                                                            vk::PhysicalDeviceDynamicRenderingFeaturesKHR,
-                                                           vk::PhysicalDeviceSynchronization2FeaturesKHR>();
+                                                           vk::PhysicalDeviceSynchronization2FeaturesKHR,
+                                                           vk::PhysicalDeviceVulkan12Features>();
 
     auto &dynamic_rendering_features = supported_features.get<vk::PhysicalDeviceDynamicRenderingFeaturesKHR>();
     auto &synchronization2_features = supported_features.get<vk::PhysicalDeviceSynchronization2FeaturesKHR>();
+    auto &vulkan12_features = supported_features.get<vk::PhysicalDeviceVulkan12Features>();
+
+    if (!vulkan12_features.timelineSemaphore) {
+        throw std::runtime_error{"Timeline semaphores are not supported by the physical device"};
+    }
+
+    // `VK_EXT_descriptor_indexing` is core since Vulkan 1.2; the bindless heap needs all of the below
+    if (!vulkan12_features.descriptorIndexing || !vulkan12_features.runtimeDescriptorArray ||
+        !vulkan12_features.descriptorBindingPartiallyBound ||
+        !vulkan12_features.descriptorBindingUpdateUnusedWhilePending ||
+        !vulkan12_features.descriptorBindingStorageBufferUpdateAfterBind ||
+        !vulkan12_features.descriptorBindingSampledImageUpdateAfterBind ||
+        !vulkan12_features.shaderStorageBufferArrayNonUniformIndexing ||
+        !vulkan12_features.shaderSampledImageArrayNonUniformIndexing) {
+        throw std::runtime_error{"Descriptor indexing is not supported by the physical device"};
+    }
 
     dynamic_rendering_features.dynamicRendering = VK_TRUE;
     synchronization2_features.synchronization2 = VK_TRUE;
+    vulkan12_features.timelineSemaphore = VK_TRUE;
 
     static constexpr auto device_extensions = std::array{VK_KHR_SWAPCHAIN_EXTENSION_NAME,
                                                          VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME,
                                                          VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME};
 
-    const auto queue_family_index = detail::find_graphics_queue_family_index(
-            physical_device.getQueueFamilyProperties());
-    auto queue_priority = 0.0f;
-    const auto device_queue_info = vk::DeviceQueueCreateInfo{{}, queue_family_index, 1, &queue_priority};
+    // one queue per distinct family: graphics, present and transfer may all share a single family
+    const auto indices = find_queue_family_indices(physical_device, surface);
+    auto unique_family_indices = std::vector{indices.graphics, indices.present, indices.transfer};
+    std::ranges::sort(unique_family_indices);
+    unique_family_indices.erase(std::ranges::unique(unique_family_indices).begin(), unique_family_indices.end());
+
+    static constexpr auto queue_priority = 0.0f;
+    auto device_queue_infos = std::vector<vk::DeviceQueueCreateInfo>{};
+    device_queue_infos.reserve(unique_family_indices.size());
+    for (const auto family_index : unique_family_indices) {
+        device_queue_infos.emplace_back(vk::DeviceQueueCreateFlags{}, family_index, 1, &queue_priority);
+    }
+
     const auto device_create_info = vk::DeviceCreateInfo{
             {},
-            device_queue_info,
+            device_queue_infos,
             {},
             device_extensions,
             // (1) Note: `device_features` rarely has a feature set.
@@ -164,11 +222,23 @@ void log_info_about_physical_device(const vk::raii::PhysicalDevice &physical_dev
     return {physical_device, device_create_info};
 }
 
+// optional: every supported feature is enabled on the logical device, so support is all it takes
+[[nodiscard]] bool query_draw_indirect_count_support(const vk::raii::PhysicalDevice &physical_device) {
+    const auto features = physical_device.getFeatures2<vk::PhysicalDeviceFeatures2,
+                                                       vk::PhysicalDeviceVulkan12Features>();
+    return features.get<vk::PhysicalDeviceFeatures2>().features.multiDrawIndirect &&
+           features.get<vk::PhysicalDeviceVulkan12Features>().drawIndirectCount;
+}
+
 } // namespace
 
 Device::Device(const vk::raii::Instance &instance, const vk::SurfaceKHR surface)
     : m_physical_device{pick_physical_device(instance)},
-      m_device{create_logical_device(m_physical_device)},
-      m_queue_families{find_queue_families(m_device, m_physical_device, surface)} {}
+      m_device{create_logical_device(m_physical_device, surface)},
+      m_allocator{*instance, *m_physical_device, *m_device},
+      m_pipeline_cache{m_physical_device, m_device, SM_ARCANE_CACHE_DIR_PATH},
+      m_supports_draw_indirect_count{query_draw_indirect_count_support(m_physical_device)},
+      m_queue_families{find_queue_families(m_device, m_physical_device, surface)},
+      m_frame_scheduler{m_device} {}
 
 } // namespace sm::arcane::vulkan
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <chrono>
 #include <cstdint>
 #include <format>
@@ -13,6 +14,9 @@
 
 #include "frame.hpp"
 #include "vulkan/device_memory.hpp"
+#include "vulkan/frame_scheduler.hpp"
+#include "vulkan/pipeline_cache.hpp"
+#include "vulkan/vma_wrapper.hpp"
 
 namespace sm::arcane::vulkan {
 
@@ -24,8 +28,11 @@ struct device_queue_families_s {
 
     family_s graphics;
     family_s present;
+    // a transfer-only family when the physical device exposes one (the DMA engine), `graphics` otherwise
+    family_s transfer;
 
     [[nodiscard]] bool are_different() const noexcept { return graphics.index != present.index; }
+    [[nodiscard]] bool has_dedicated_transfer() const noexcept { return transfer.index != graphics.index; }
 };
 
 class Device {
@@ -35,11 +42,17 @@ public:
 
     [[nodiscard]] const vk::raii::PhysicalDevice &physical_device() const noexcept { return m_physical_device; }
     [[nodiscard]] const vk::raii::Device &device() const noexcept { return m_device; }
+    [[nodiscard]] const vma::Allocator &allocator() const noexcept { return m_allocator; }
+    [[nodiscard]] const PipelineCache &pipeline_cache() const noexcept { return m_pipeline_cache; }
     [[nodiscard]] device_queue_families_s queue_families() const noexcept { return m_queue_families; }
+    // `vkCmdDrawIndexedIndirectCount` with more than one draw; without it draws are culled and recorded on the CPU
+    [[nodiscard]] bool supports_draw_indirect_count() const noexcept { return m_supports_draw_indirect_count; }
 
     [[nodiscard]] frame_info_s &frame_info() noexcept { return m_current_frame_info; }
     [[nodiscard]] std::uint32_t frame_index() const noexcept { return m_current_frame_info.frame_index; }
     [[nodiscard]] std::uint32_t image_index() const noexcept { return m_current_frame_info.image_index; }
+    [[nodiscard]] FrameScheduler &frame_scheduler() noexcept { return m_frame_scheduler; }
+    [[nodiscard]] const FrameScheduler &frame_scheduler() const noexcept { return m_frame_scheduler; }
     [[nodiscard]] float frame_dt() const noexcept {
         return std::chrono::duration<float>(std::chrono::steady_clock::now() - m_current_frame_info.started_time)
                 .count();
@@ -48,10 +61,16 @@ public:
     [[nodiscard]] DeviceMemoryBuffer create_device_memory_buffer(
             const vk::Flags<vk::BufferUsageFlagBits> usages,
             const vk::DeviceSize size,
-            const vk::DeviceSize offset = 0,
             vk::MemoryPropertyFlags memory_property_flags = vk::MemoryPropertyFlagBits::eHostVisible |
                                                             vk::MemoryPropertyFlagBits::eHostCoherent) const {
-        return {m_physical_device, m_device, usages, size, offset, memory_property_flags};
+        // the upload service writes transfer destinations from its own queue family; concurrent sharing avoids
+        // explicit queue family ownership transfers for buffers
+        if ((usages & vk::BufferUsageFlagBits::eTransferDst) && m_queue_families.has_dedicated_transfer()) {
+            const auto queue_family_indices = std::array{m_queue_families.graphics.index,
+                                                         m_queue_families.transfer.index};
+            return {m_allocator, usages, size, memory_property_flags, queue_family_indices};
+        }
+        return {m_allocator, usages, size, memory_property_flags};
     }
 
     [[nodiscard]] DeviceMemoryImage create_device_memory_image(const vk::Format format,
@@ -61,7 +80,7 @@ public:
                                                                const vk::ImageLayout initial_layout,
                                                                const vk::MemoryPropertyFlags memory_properties,
                                                                const vk::ImageAspectFlags aspect_mask) const {
-        return {m_physical_device,
+        return {m_allocator,
                 m_device,
                 format,
                 extent,
@@ -83,10 +102,16 @@ public:
 private:
     vk::raii::PhysicalDevice m_physical_device;
     vk::raii::Device m_device;
+    // every buffer and image is sub-allocated from here; declared after `m_device` so it is destroyed first
+    vma::Allocator m_allocator;
+    // shared by every pipeline; saved to disk on destruction, while `m_device` is still alive
+    PipelineCache m_pipeline_cache;
+    bool m_supports_draw_indirect_count;
 
     device_queue_families_s m_queue_families;
 
     frame_info_s m_current_frame_info;
+    FrameScheduler m_frame_scheduler;
 };
 
 } // namespace sm::arcane::vulkan
\ No newline at end of file
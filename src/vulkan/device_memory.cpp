@@ -1,61 +1,47 @@
 #include "device_memory.hpp"
 
-#include <limits>
-
 namespace sm::arcane::vulkan {
 
 namespace {
 
-[[nodiscard]] std::uint32_t find_memory_type(const vk::PhysicalDeviceMemoryProperties &memory_properties,
-                                             std::uint32_t type_bits,
-                                             const vk::MemoryPropertyFlags requirements_mask) noexcept {
-    auto type_index = std::numeric_limits<std::uint32_t>::max();
-    for (auto i = 0u; i < memory_properties.memoryTypeCount; ++i) {
-        if ((type_bits & 1) &&
-            ((memory_properties.memoryTypes[i].propertyFlags & requirements_mask) == requirements_mask)) {
-            type_index = i;
-            break;
-        }
-        type_bits >>= 1;
+// `requiredFlags` keeps the caller's memory property contract exactly; VMA picks the memory type and sub-allocates the
+// resource from one of its large blocks instead of a `vkAllocateMemory` per resource
+[[nodiscard]] VmaAllocationCreateInfo make_allocation_create_info(const vk::MemoryPropertyFlags memory_property_flags) {
+    auto allocation_create_info = VmaAllocationCreateInfo{};
+    allocation_create_info.usage = VMA_MEMORY_USAGE_AUTO;
+    allocation_create_info.requiredFlags = static_cast<VkMemoryPropertyFlags>(memory_property_flags);
+    if (memory_property_flags & vk::MemoryPropertyFlagBits::eHostVisible) {
+        // `VMA_MEMORY_USAGE_AUTO` allocations may only be mapped when the host access pattern is declared; the mapping
+        // itself is persistent, so uploads on the hot path never go through `vkMapMemory`/`vkUnmapMemory`
+        allocation_create_info.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                                       VMA_ALLOCATION_CREATE_MAPPED_BIT;
     }
-    assert(type_index != std::numeric_limits<std::uint32_t>::max());
-
-    return type_index;
-}
-
-[[nodiscard]] vk::raii::DeviceMemory allocate_device_memory_impl(
-        const vk::raii::Device &device,
-        const vk::PhysicalDeviceMemoryProperties memory_properties,
-        const vk::MemoryRequirements2 requirements,
-        const vk::MemoryPropertyFlags memory_property_flags) {
-    const auto memory_type_index = find_memory_type(memory_properties,
-                                                    requirements.memoryRequirements.memoryTypeBits,
-                                                    memory_property_flags);
-    return device.allocateMemory({requirements.memoryRequirements.size, memory_type_index});
+    return allocation_create_info;
 }
 
 } // namespace
 
 DeviceMemoryBuffer::DeviceMemoryBuffer(
-        const vk::raii::PhysicalDevice &physical_device,
-        const vk::raii::Device &device,
+        const vma::Allocator &allocator,
         const vk::BufferUsageFlags usages,
         const vk::DeviceSize size,
-        const vk::DeviceSize offset,
         const vk::MemoryPropertyFlags property_flags /* = vk::MemoryPropertyFlagBits::eHostVisible |
-                                                          vk::MemoryPropertyFlagBits::eHostCoherent */)
-    : physical_device{*physical_device},
-      device{*device},
-      buffer{device, {{}, size, usages}},
-      device_memory{[&] {
-          assert(*buffer && "vk::raii::Buffer must be initialized for the allocation");
-          assert(property_flags && "Memory property flags for vk::raii::Buffer must be initialized");
-          auto device_memory = allocate_device_memory_impl(device,
-                                             physical_device.getMemoryProperties(),
-                                             device.getBufferMemoryRequirements2(*buffer),
-                                             property_flags);
-          buffer.bindMemory(device_memory, offset);
-          return device_memory;
+                                                          vk::MemoryPropertyFlagBits::eHostCoherent */,
+        const std::span<const std::uint32_t> queue_family_indices /* = {} */)
+    : buffer{[&] {
+          assert(property_flags && "Memory property flags for vk::Buffer must be initialized");
+          const auto sharing_mode = queue_family_indices.size() > 1 ? vk::SharingMode::eConcurrent
+                                                                    : vk::SharingMode::eExclusive;
+          return allocator.allocate_buffer(
+                  vk::BufferCreateInfo{{},
+                                       size,
+                                       usages,
+                                       sharing_mode,
+                                       sharing_mode == vk::SharingMode::eConcurrent
+                                               ? static_cast<std::uint32_t>(queue_family_indices.size())
+                                               : 0u,
+                                       queue_family_indices.data()},
+                  make_allocation_create_info(property_flags));
       }()}
 #if SM_ARCANE_DEBUG_MODE
       ,
@@ -64,9 +50,15 @@ DeviceMemoryBuffer::DeviceMemoryBuffer(
       property_flags{property_flags}
 #endif
 {
+    if (property_flags & vk::MemoryPropertyFlagBits::eHostVisible) {
+        m_mapped_data = buffer.allocation_info().pMappedData;
+        m_mapped_size = size;
+        m_requires_flush = !(buffer.memory_property_flags() & vk::MemoryPropertyFlagBits::eHostCoherent);
+        assert(m_mapped_data && "Host-visible allocation must be persistently mapped");
+    }
 }
 
-DeviceMemoryImage::DeviceMemoryImage(const vk::raii::PhysicalDevice &physical_device,
+DeviceMemoryImage::DeviceMemoryImage(const vma::Allocator &allocator,
                                      const vk::raii::Device &device,
                                      const vk::Format format,
                                      const vk::Extent2D extent,
@@ -75,33 +67,24 @@ DeviceMemoryImage::DeviceMemoryImage(const vk::raii::PhysicalDevice &physical_de
                                      const vk::ImageLayout initial_layout,
                                      const vk::MemoryPropertyFlags memory_properties,
                                      const vk::ImageAspectFlags aspect_mask)
-    : physical_device{*physical_device},
-      device{*device},
-      format{format},
-      image{device,
-            {{},
-             vk::ImageType::e2D,
-             format,
-             vk::Extent3D{extent, 1},
-             1,
-             1,
-             vk::SampleCountFlagBits::e1,
-             tiling,
-             usage,
-             vk::SharingMode::eExclusive,
-             {},
-             nullptr,
-             initial_layout}},
-      device_memory{[&] {
-          assert(*image && "vk::raii::Image must be initialized before the allocation");
-          assert(memory_properties && "Memory property flags for vk::raii::Image must be initialized");
-          auto device_memory = allocate_device_memory_impl(device,
-                                                           physical_device.getMemoryProperties(),
-                                                           device.getImageMemoryRequirements2(*image),
-                                                           memory_properties);
-          image.bindMemory(device_memory, 0);
-          return device_memory;
+    : format{format},
+      image{[&] {
+          assert(memory_properties && "Memory property flags for vk::Image must be initialized");
+          return allocator.allocate_image(vk::ImageCreateInfo{{},
+                                                              vk::ImageType::e2D,
+                                                              format,
+                                                              vk::Extent3D{extent, 1},
+                                                              1,
+                                                              1,
+                                                              vk::SampleCountFlagBits::e1,
+                                                              tiling,
+                                                              usage,
+                                                              vk::SharingMode::eExclusive,
+                                                              {},
+                                                              nullptr,
+                                                              initial_layout},
+                                          make_allocation_create_info(memory_properties));
       }()},
-      image_view{device, {{}, image, vk::ImageViewType::e2D, format, {}, {aspect_mask, 0, 1, 0, 1}}} {}
+      image_view{device, {{}, *image, vk::ImageViewType::e2D, format, {}, {aspect_mask, 0, 1, 0, 1}}} {}
 
 } // namespace sm::arcane::vulkan
\ No newline at end of file
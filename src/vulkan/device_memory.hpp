@@ -7,11 +7,13 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <span>
 #include <utility>
-#include <vector>
 
 #include <vulkan/vulkan_raii.hpp>
 
+#include "vulkan/vma_wrapper.hpp"
+
 namespace sm::arcane::vulkan {
 
 struct DeviceMemoryBuffer {
@@ -19,7 +21,8 @@ private:
     template<typename T>
     void copy_to_memory(const T *src_ptr, const std::size_t count, const vk::DeviceSize stride = sizeof(T)) {
         assert(sizeof(T) <= stride);
-        auto *dst_ptr = static_cast<std::uint8_t *>(device_memory.mapMemory(0, count * stride, {}));
+        assert(count * stride <= m_mapped_size);
+        auto *dst_ptr = static_cast<std::uint8_t *>(m_mapped_data);
         if (stride == sizeof(T)) {
             std::memcpy(dst_ptr, src_ptr, count * sizeof(T));
         } else {
@@ -28,7 +31,7 @@ private:
                 dst_ptr += stride;
             }
         }
-        device_memory.unmapMemory();
+        flush(0, count * stride);
     }
 
     template<typename T>
@@ -36,90 +39,69 @@ private:
         copy_to_memory<T>(&data, 1);
     }
 
-    vk::PhysicalDevice physical_device = nullptr;
-    vk::Device device = nullptr;
+    // host-visible buffers stay mapped for their whole lifetime, the pointer is owned by the VMA allocation
+    void *m_mapped_data = nullptr;
+    vk::DeviceSize m_mapped_size = 0;
+    bool m_requires_flush = false;
 
 public:
-    vk::raii::Buffer buffer = nullptr;
-    vk::raii::DeviceMemory device_memory = nullptr;
+    vma::allocated_buffer_t buffer = nullptr;
 #if !defined(_NDEBUG)
     vk::DeviceSize size{};
     vk::BufferUsageFlags usages{};
     vk::MemoryPropertyFlags property_flags{};
 #endif
 
-    DeviceMemoryBuffer(const vk::raii::PhysicalDevice &physical_device,
-                       const vk::raii::Device &device,
+    // more than one of `queue_family_indices` makes the buffer `vk::SharingMode::eConcurrent` between those families
+    DeviceMemoryBuffer(const vma::Allocator &allocator,
                        vk::BufferUsageFlags usages,
                        vk::DeviceSize size,
-                       vk::DeviceSize offset = 0,
                        vk::MemoryPropertyFlags property_flags = vk::MemoryPropertyFlagBits::eHostVisible |
-                                                                vk::MemoryPropertyFlagBits::eHostCoherent);
+                                                                vk::MemoryPropertyFlagBits::eHostCoherent,
+                       std::span<const std::uint32_t> queue_family_indices = {});
 
     explicit(false) DeviceMemoryBuffer(std::nullptr_t) {}
 
+    [[nodiscard]] bool is_mapped() const noexcept { return m_mapped_data != nullptr; }
+
+    [[nodiscard]] void *mapped_data() const noexcept {
+        assert(is_mapped() && "Only host-visible buffers are mapped");
+        return m_mapped_data;
+    }
+
     template<typename T>
-    void upload(const T &data) {
-        assert((property_flags & vk::MemoryPropertyFlagBits::eHostCoherent) &&
-               (property_flags & vk::MemoryPropertyFlagBits::eHostVisible));
-        assert(sizeof(T) <= size);
+    [[nodiscard]] std::span<T> mapped_span() const noexcept {
+        return {static_cast<T *>(mapped_data()), static_cast<std::size_t>(m_mapped_size / sizeof(T))};
+    }
 
-        auto *data_ptr = device_memory.mapMemory(0, sizeof(T), {});
-        std::memcpy(data_ptr, &data, sizeof(T));
-        device_memory.unmapMemory();
+    // makes host writes to `mapped_data()` visible to the device; only non-coherent memory types need it
+    void flush(const vk::DeviceSize offset = 0, const vk::DeviceSize range = vk::WholeSize) const {
+        if (m_requires_flush) {
+            buffer.flush(offset, range);
+        }
     }
 
     template<typename T>
-    void upload(const T *data, const std::size_t count, const std::size_t stride = sizeof(T)) {
+    void upload(const T &data) {
         assert(property_flags & vk::MemoryPropertyFlagBits::eHostVisible);
+        assert(sizeof(T) <= size);
 
-        const auto element_size = stride ? stride : sizeof(T);
-        assert(sizeof(T) <= element_size);
-
-        copy_to_memory(data, count, element_size);
+        copy_to_memory(data);
     }
 
     template<typename T>
-    void upload(const vk::raii::PhysicalDevice &physical_device,
-                const vk::raii::Device &device,
-                const vk::Queue queue,
-                const vk::CommandPool command_pool,
-                const std::vector<T> &data,
-                const std::size_t stride) {
-        assert(usages & vk::BufferUsageFlagBits::eTransferDst);
-        assert(property_flags & vk::MemoryPropertyFlagBits::eDeviceLocal);
+    void upload(const T *data, const std::size_t count, const std::size_t stride = sizeof(T)) {
+        assert(property_flags & vk::MemoryPropertyFlagBits::eHostVisible);
 
         const auto element_size = stride ? stride : sizeof(T);
         assert(sizeof(T) <= element_size);
 
-        const auto data_size = data.size() * element_size;
-        assert(data_size <= size);
-
-        auto staging_buffer = vulkan::DeviceMemoryBuffer{physical_device,
-                                                         device,
-                                                         vk::BufferUsageFlagBits::eTransferSrc,
-                                                         data_size};
-        staging_buffer.upload(data.data(), data.size(), element_size);
-
-        const auto command_buffer = vk::raii::CommandBuffer{std::move(
-                vk::raii::CommandBuffers{device, {command_pool, vk::CommandBufferLevel::ePrimary, 1}}.front())};
-        command_buffer.begin(vk::CommandBufferBeginInfo{vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
-        command_buffer.copyBuffer(*staging_buffer.buffer, *buffer, vk::BufferCopy{0, 0, data_size});
-        command_buffer.end();
-
-        const auto submit_info = vk::SubmitInfo{nullptr, nullptr, *command_buffer};
-        queue.submit(submit_info, nullptr);
-        queue.waitIdle();
+        copy_to_memory(data, count, element_size);
     }
 };
 
 struct DeviceMemoryImage {
-private:
-    vk::PhysicalDevice physical_device = nullptr;
-    vk::Device device = nullptr;
-
-public:
-    DeviceMemoryImage(const vk::raii::PhysicalDevice &physical_device,
+    DeviceMemoryImage(const vma::Allocator &allocator,
                       const vk::raii::Device &device,
                       vk::Format format,
                       vk::Extent2D extent,
@@ -131,11 +113,22 @@ public:
 
     explicit(false) DeviceMemoryImage(std::nullptr_t) {}
 
-    // the DeviceMemory should be destroyed before the Image it is bound to; to get that order with the standard
-    // destructor of the ImageData, the order of DeviceMemory and Image here matters
+    DeviceMemoryImage(DeviceMemoryImage &&) noexcept = default;
+
+    // the view has to be released before the image it refers to, so it is assigned first
+    DeviceMemoryImage &operator=(DeviceMemoryImage &&other) noexcept {
+        if (this != &other) {
+            format = other.format;
+            image_view = std::move(other.image_view);
+            image = std::move(other.image);
+        }
+        return *this;
+    }
+
+    // the ImageView should be destroyed before the Image it refers to; to get that order with the standard
+    // destructor of the DeviceMemoryImage, the order of Image and ImageView here matters
     vk::Format format{};
-    vk::raii::Image image = nullptr;
-    vk::raii::DeviceMemory device_memory = nullptr;
+    vma::allocated_image_t image = nullptr;
     vk::raii::ImageView image_view = nullptr;
 };
 
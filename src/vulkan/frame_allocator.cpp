@@ -0,0 +1,61 @@
+#include "frame_allocator.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace sm::arcane::vulkan {
+
+namespace {
+
+[[nodiscard]] constexpr vk::DeviceSize align_up(const vk::DeviceSize value, const vk::DeviceSize alignment) noexcept {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+[[nodiscard]] vk::DeviceSize pick_alignment(const vk::raii::PhysicalDevice &physical_device) {
+    const auto limits = physical_device.getProperties().limits;
+    // every allocation can be bound as either a uniform or a storage buffer
+    return std::max({limits.minUniformBufferOffsetAlignment,
+                     limits.minStorageBufferOffsetAlignment,
+                     vk::DeviceSize{alignof(std::max_align_t)}});
+}
+
+} // namespace
+
+FrameAllocator::FrameAllocator(const Device &device,
+                               const std::uint32_t frames_in_flight,
+                               const vk::DeviceSize frame_arena_size)
+    : m_buffer{device.create_device_memory_buffer(
+              vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eStorageBuffer |
+                      vk::BufferUsageFlagBits::eIndirectBuffer,
+              frame_arena_size * frames_in_flight)},
+      m_memory{m_buffer.mapped_span<std::byte>()},
+      m_frame_arena_size{frame_arena_size},
+      m_alignment{pick_alignment(device.physical_device())} {
+    assert(frames_in_flight > 0);
+    // dynamic offsets are 32-bit
+    assert(frame_arena_size * frames_in_flight <= std::numeric_limits<std::uint32_t>::max());
+    assert(frame_arena_size % m_alignment == 0);
+}
+
+void FrameAllocator::begin_frame(const std::uint32_t frame_index) noexcept {
+    m_frame_begin = frame_index * m_frame_arena_size;
+    m_frame_head = m_frame_begin;
+    assert(m_frame_begin + m_frame_arena_size <= m_memory.size());
+}
+
+void FrameAllocator::end_frame() const { m_buffer.flush(m_frame_begin, m_frame_head - m_frame_begin); }
+
+FrameAllocator::allocation_s FrameAllocator::allocate(const vk::DeviceSize size, const vk::DeviceSize alignment) {
+    const auto offset = align_up(m_frame_head, std::max(alignment, m_alignment));
+    if (offset + size > m_frame_begin + m_frame_arena_size) {
+        throw std::runtime_error{"FrameAllocator is out of memory for the current frame"};
+    }
+    m_frame_head = offset + size;
+
+    return {.buffer = *m_buffer.buffer,
+            .offset = offset,
+            .memory = m_memory.subspan(static_cast<std::size_t>(offset), static_cast<std::size_t>(size))};
+}
+
+} // namespace sm::arcane::vulkan
\ No newline at end of file
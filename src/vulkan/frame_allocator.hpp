@@ -0,0 +1,95 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "vulkan/device.hpp"
+#include "vulkan/device_memory.hpp"
+
+namespace sm::arcane::vulkan {
+
+inline constexpr auto g_default_frame_arena_size = vk::DeviceSize{4} * 1024 * 1024;
+
+// Per-frame linear ("bump") allocator over one persistently mapped buffer split into a slot per frame in flight.
+// Everything allocated during a frame lives until the same slot comes around again, i.e. until the GPU has retired that
+// frame (see `FrameScheduler::begin_frame`), so nothing is ever freed individually. Allocations are aligned for both
+// uniform and storage buffer bindings and are meant to be bound through `eUniformBufferDynamic` /
+// `eStorageBufferDynamic` descriptors written once against `buffer()`, passing `allocation_s::dynamic_offset()`. The
+// GPU may also write an allocation of its own frame, e.g. indirect draw commands that are read back as such
+class FrameAllocator {
+public:
+    struct allocation_s {
+        vk::Buffer buffer;
+        vk::DeviceSize offset;
+        std::span<std::byte> memory;
+
+        [[nodiscard]] std::uint32_t dynamic_offset() const noexcept { return static_cast<std::uint32_t>(offset); }
+
+        template<typename T>
+        [[nodiscard]] std::span<T> as() const noexcept {
+            return {reinterpret_cast<T *>(memory.data()), memory.size() / sizeof(T)};
+        }
+    };
+
+    FrameAllocator(const Device &device,
+                   std::uint32_t frames_in_flight,
+                   vk::DeviceSize frame_arena_size = g_default_frame_arena_size);
+
+    FrameAllocator(const FrameAllocator &) = delete;
+    FrameAllocator &operator=(const FrameAllocator &) = delete;
+    FrameAllocator(FrameAllocator &&) noexcept = delete;
+    FrameAllocator &operator=(FrameAllocator &&) noexcept = delete;
+
+    ~FrameAllocator() = default;
+
+    [[nodiscard]] vk::Buffer buffer() const noexcept { return *m_buffer.buffer; }
+    [[nodiscard]] vk::DeviceSize frame_arena_size() const noexcept { return m_frame_arena_size; }
+    [[nodiscard]] vk::DeviceSize alignment() const noexcept { return m_alignment; }
+
+    // must be called once the GPU is done with the previous use of `frame_index`
+    void begin_frame(std::uint32_t frame_index) noexcept;
+
+    // makes the host writes of the current frame visible to the device; only non-coherent memory needs it
+    void end_frame() const;
+
+    [[nodiscard]] allocation_s allocate(vk::DeviceSize size, vk::DeviceSize alignment = 0);
+
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    [[nodiscard]] allocation_s push(const T &value) {
+        const auto allocation = allocate(sizeof(T));
+        std::memcpy(allocation.memory.data(), &value, sizeof(T));
+        return allocation;
+    }
+
+    template<std::ranges::contiguous_range Range>
+        requires std::is_trivially_copyable_v<std::ranges::range_value_t<Range>>
+    [[nodiscard]] allocation_s push_range(const Range &values) {
+        const auto bytes = std::as_bytes(std::span{values});
+        const auto allocation = allocate(bytes.size());
+        std::memcpy(allocation.memory.data(), bytes.data(), bytes.size());
+        return allocation;
+    }
+
+private:
+    DeviceMemoryBuffer m_buffer;
+    std::span<std::byte> m_memory;
+
+    vk::DeviceSize m_frame_arena_size;
+    vk::DeviceSize m_alignment;
+
+    vk::DeviceSize m_frame_begin = 0;
+    vk::DeviceSize m_frame_head = 0;
+};
+
+} // namespace sm::arcane::vulkan
\ No newline at end of file
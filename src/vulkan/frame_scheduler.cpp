@@ -0,0 +1,58 @@
+#include "frame_scheduler.hpp"
+
+#include <limits>
+
+namespace sm::arcane::vulkan {
+
+namespace {
+
+[[nodiscard]] vk::raii::Semaphore create_timeline_semaphore(const vk::raii::Device &device) {
+    const auto type_create_info = vk::SemaphoreTypeCreateInfo{vk::SemaphoreType::eTimeline, 0};
+    return {device, vk::SemaphoreCreateInfo{{}, &type_create_info}};
+}
+
+} // namespace
+
+FrameScheduler::FrameScheduler(const vk::raii::Device &device)
+    : m_device{device},
+      m_timeline{create_timeline_semaphore(m_device)} {}
+
+std::uint64_t FrameScheduler::completed_frame() const { return m_timeline.getCounterValue(); }
+
+void FrameScheduler::wait_for_frame(const std::uint64_t frame) const {
+    if (frame >= m_frame_counter) {
+        // waiting for a frame that hasn't been submitted yet would never return
+        return;
+    }
+
+    const auto wait_info = vk::SemaphoreWaitInfo{{}, 1, &*m_timeline, &frame};
+    while (vk::Result::eTimeout == m_device.waitSemaphores(wait_info, std::numeric_limits<std::uint64_t>::max()))
+        ;
+}
+
+void FrameScheduler::begin_frame(const std::uint32_t frames_in_flight) {
+    if (m_frame_counter > frames_in_flight) {
+        wait_for_frame(m_frame_counter - frames_in_flight);
+    }
+    collect();
+}
+
+void FrameScheduler::defer(std::function<void()> &&callback) {
+    m_deferred_callbacks.emplace_back(m_frame_counter, std::move(callback));
+}
+
+void FrameScheduler::collect() {
+    const auto completed = completed_frame();
+
+    while (!m_deferred_callbacks.empty() && m_deferred_callbacks.front().first <= completed) {
+        auto callback = std::move(m_deferred_callbacks.front().second);
+        m_deferred_callbacks.pop_front();
+        callback();
+    }
+
+    while (!m_deferred_objects.empty() && m_deferred_objects.front().first <= completed) {
+        m_deferred_objects.pop_front();
+    }
+}
+
+} // namespace sm::arcane::vulkan
@@ -0,0 +1,66 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <vulkan/vulkan_raii.hpp>
+
+namespace sm::arcane::vulkan {
+
+// The GPU clock of the engine: a single timeline semaphore where the submission of frame N signals the value N.
+// Any subsystem that has to know when the GPU is done with a frame (uploads, readbacks, deferred deletions) waits on
+// the same timeline instead of managing its own fences
+class FrameScheduler {
+public:
+    explicit FrameScheduler(const vk::raii::Device &device);
+
+    FrameScheduler(const FrameScheduler &) = delete;
+    FrameScheduler &operator=(const FrameScheduler &) = delete;
+    FrameScheduler(FrameScheduler &&) noexcept = delete;
+    FrameScheduler &operator=(FrameScheduler &&) noexcept = delete;
+
+    ~FrameScheduler() = default;
+
+    [[nodiscard]] vk::Semaphore timeline() const noexcept { return *m_timeline; }
+
+    // the number of the frame being recorded now; its submission signals exactly this value
+    [[nodiscard]] std::uint64_t current_frame() const noexcept { return m_frame_counter; }
+    [[nodiscard]] std::uint64_t completed_frame() const;
+    [[nodiscard]] bool is_frame_completed(std::uint64_t frame) const { return frame <= completed_frame(); }
+    void wait_for_frame(std::uint64_t frame) const;
+
+    // blocks until the frame that used the same slot `frames_in_flight` frames ago has been retired by the GPU
+    void begin_frame(std::uint32_t frames_in_flight);
+    void end_frame() noexcept { ++m_frame_counter; }
+
+    // the callback runs once all the work submitted up to (and including) the current frame is completed
+    void defer(std::function<void()> &&callback);
+
+    // keeps `object` alive until all the work submitted up to (and including) the current frame is completed
+    template<typename T>
+    void defer_destruction(T &&object) {
+        m_deferred_objects.emplace_back(m_frame_counter, std::make_shared<std::decay_t<T>>(std::forward<T>(object)));
+    }
+
+    // executes the deferred work of the completed frames
+    void collect();
+
+private:
+    const vk::raii::Device &m_device;
+    vk::raii::Semaphore m_timeline;
+
+    // starts at 1: the semaphore is created with 0, which means "no frame is completed yet"
+    std::uint64_t m_frame_counter = 1;
+
+    std::deque<std::pair<std::uint64_t, std::function<void()>>> m_deferred_callbacks;
+    std::deque<std::pair<std::uint64_t, std::shared_ptr<void>>> m_deferred_objects;
+};
+
+} // namespace sm::arcane::vulkan
@@ -0,0 +1,180 @@
+#include "geometry_pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <tuple>
+#include <utility>
+
+namespace sm::arcane::vulkan {
+
+GeometryPool::GeometryPool(Device &device,
+                           UploadService &upload_service,
+                           BindlessHeap &bindless_heap,
+                           const vk::DeviceSize vertex_block_size,
+                           const vk::DeviceSize index_block_size,
+                           const vk::DeviceSize table_block_size)
+    : m_device{device},
+      m_upload_service{upload_service},
+      m_bindless_heap{bindless_heap},
+      m_vertex_block_size{vertex_block_size},
+      m_index_block_size{index_block_size},
+      m_table_block_size{table_block_size} {}
+
+GeometryPool::~GeometryPool() {
+    for (const auto &block : m_blocks) {
+        m_bindless_heap.release_storage_buffer(block.table_id);
+    }
+}
+
+bool GeometryPool::try_allocate(block_s &block,
+                                const std::uint64_t vertex_size,
+                                const vk::DeviceSize vertex_stride,
+                                const std::uint64_t index_count,
+                                const std::uint64_t table_element_count,
+                                geometry_allocation_s &allocation) {
+    const auto vertices = block.vertex_ranges.allocate(vertex_size, vertex_stride);
+    if (!vertices) {
+        return false;
+    }
+
+    auto indices = util::RangeAllocator::range_s{};
+    if (index_count > 0) {
+        const auto index_range = block.index_ranges.allocate(index_count);
+        if (!index_range) {
+            block.vertex_ranges.free(*vertices);
+            return false;
+        }
+        indices = *index_range;
+    }
+
+    auto table = util::RangeAllocator::range_s{};
+    if (table_element_count > 0) {
+        const auto table_range = block.table_ranges.allocate(table_element_count);
+        if (!table_range) {
+            block.vertex_ranges.free(*vertices);
+            if (indices.size > 0) {
+                block.index_ranges.free(indices);
+            }
+            return false;
+        }
+        table = *table_range;
+    }
+
+    allocation.vertices = *vertices;
+    allocation.indices = indices;
+    allocation.table = table;
+    allocation.vertex_stride = vertex_stride;
+    return true;
+}
+
+GeometryPool::block_s &GeometryPool::add_block(const vk::DeviceSize min_vertex_size,
+                                               const vk::DeviceSize min_index_size,
+                                               const vk::DeviceSize min_table_size) {
+    // a mesh larger than a regular block gets a block of its own size
+    const auto vertex_size = std::max(m_vertex_block_size, min_vertex_size);
+    const auto index_size = std::max(m_index_block_size, min_index_size);
+    const auto table_size = std::max(m_table_block_size, min_table_size);
+
+    auto table_buffer = m_device.create_device_memory_buffer(vk::BufferUsageFlagBits::eStorageBuffer |
+                                                                     vk::BufferUsageFlagBits::eTransferDst,
+                                                             table_size,
+                                                             vk::MemoryPropertyFlagBits::eDeviceLocal);
+    const auto table_id = m_bindless_heap.register_storage_buffer(*table_buffer.buffer);
+    return m_blocks.emplace_back(
+            m_device.create_device_memory_buffer(vk::BufferUsageFlagBits::eVertexBuffer |
+                                                         vk::BufferUsageFlagBits::eTransferDst,
+                                                 vertex_size,
+                                                 vk::MemoryPropertyFlagBits::eDeviceLocal),
+            m_device.create_device_memory_buffer(vk::BufferUsageFlagBits::eIndexBuffer |
+                                                         vk::BufferUsageFlagBits::eTransferDst,
+                                                 index_size,
+                                                 vk::MemoryPropertyFlagBits::eDeviceLocal),
+            std::move(table_buffer),
+            table_id,
+            util::RangeAllocator{vertex_size},
+            util::RangeAllocator{index_size / sizeof(std::uint32_t)},
+            util::RangeAllocator{table_size / g_geometry_table_element_size});
+}
+
+void GeometryPool::collect() {
+    if (m_released_allocations.empty()) {
+        return;
+    }
+
+    const auto completed_frame = m_device.frame_scheduler().completed_frame();
+    while (!m_released_allocations.empty() && m_released_allocations.front().first <= completed_frame) {
+        const auto &allocation = m_released_allocations.front().second;
+        auto &block = m_blocks[allocation.block];
+        block.vertex_ranges.free(allocation.vertices);
+        if (allocation.indices.size > 0) {
+            block.index_ranges.free(allocation.indices);
+        }
+        if (allocation.table.size > 0) {
+            block.table_ranges.free(allocation.table);
+        }
+        m_released_allocations.pop_front();
+    }
+}
+
+geometry_allocation_s GeometryPool::allocate(const std::span<const std::byte> vertices,
+                                             const vk::DeviceSize vertex_stride,
+                                             const std::span<const std::uint32_t> indices,
+                                             const std::span<const std::byte> table) {
+    assert(!vertices.empty() && vertices.size() % vertex_stride == 0);
+    assert(table.size() % g_geometry_table_element_size == 0);
+
+    collect();
+
+    const auto table_element_count = table.size() / g_geometry_table_element_size;
+    auto allocation = geometry_allocation_s{};
+    auto found = false;
+    for (auto i = std::uint32_t{0}; i < m_blocks.size() && !found; ++i) {
+        found = try_allocate(m_blocks[i],
+                             vertices.size(),
+                             vertex_stride,
+                             indices.size(),
+                             table_element_count,
+                             allocation);
+        allocation.block = i;
+    }
+    if (!found) {
+        allocation.block = static_cast<std::uint32_t>(m_blocks.size());
+        found = try_allocate(add_block(vertices.size(), indices.size_bytes(), table.size()),
+                             vertices.size(),
+                             vertex_stride,
+                             indices.size(),
+                             table_element_count,
+                             allocation);
+        assert(found);
+    }
+
+    // the copies are batched with the other uploads; the frame that draws the mesh waits for them on the GPU
+    const auto &block = m_blocks[allocation.block];
+    std::ignore = m_upload_service.enqueue(*block.vertex_buffer.buffer, allocation.vertices.offset, vertices);
+    if (!indices.empty()) {
+        std::ignore = m_upload_service.enqueue(*block.index_buffer.buffer,
+                                               allocation.indices.offset * sizeof(std::uint32_t),
+                                               std::as_bytes(indices));
+    }
+    if (!table.empty()) {
+        std::ignore = m_upload_service.enqueue(*block.table_buffer.buffer,
+                                               allocation.table.offset * g_geometry_table_element_size,
+                                               table);
+    }
+
+    return allocation;
+}
+
+void GeometryPool::release(const geometry_allocation_s &allocation) {
+    // the frames recorded so far may still draw from the ranges. The pool keeps the pending ranges itself: a callback
+    // deferred to the device could outlive the pool
+    m_released_allocations.emplace_back(m_device.frame_scheduler().current_frame(), allocation);
+}
+
+void GeometryPool::bind(const vk::CommandBuffer command_buffer, const std::uint32_t block_index) const noexcept {
+    const auto &block = m_blocks[block_index];
+    command_buffer.bindVertexBuffers(0, *block.vertex_buffer.buffer, vk::DeviceSize{0});
+    command_buffer.bindIndexBuffer(*block.index_buffer.buffer, 0, vk::IndexType::eUint32);
+}
+
+} // namespace sm::arcane::vulkan
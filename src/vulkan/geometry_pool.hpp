@@ -0,0 +1,126 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "util/range_allocator.hpp"
+#include "vulkan/bindless_heap.hpp"
+#include "vulkan/device.hpp"
+#include "vulkan/device_memory.hpp"
+#include "vulkan/upload_service.hpp"
+
+namespace sm::arcane::vulkan {
+
+inline constexpr auto g_default_geometry_vertex_block_size = vk::DeviceSize{64} * 1024 * 1024;
+inline constexpr auto g_default_geometry_index_block_size = vk::DeviceSize{32} * 1024 * 1024;
+inline constexpr auto g_default_geometry_table_block_size = vk::DeviceSize{8} * 1024 * 1024;
+// the tables of the meshes are addressed by element of this size, which their entries share
+inline constexpr auto g_geometry_table_element_size = vk::DeviceSize{32};
+
+// where the geometry of one mesh lives in a `GeometryPool`
+struct geometry_allocation_s {
+    std::uint32_t block = 0;
+    util::RangeAllocator::range_s vertices;
+    // in 32-bit indices; empty for non-indexed geometry
+    util::RangeAllocator::range_s indices;
+    // in table elements; empty for geometry without a table
+    util::RangeAllocator::range_s table;
+    vk::DeviceSize vertex_stride = 0;
+
+    // the `vertexOffset` / `firstVertex` of the draws
+    [[nodiscard]] std::uint32_t base_vertex() const noexcept {
+        return static_cast<std::uint32_t>(vertices.offset / vertex_stride);
+    }
+    [[nodiscard]] std::uint32_t first_index() const noexcept { return static_cast<std::uint32_t>(indices.offset); }
+    [[nodiscard]] std::uint32_t first_table_element() const noexcept {
+        return static_cast<std::uint32_t>(table.offset);
+    }
+};
+
+// Vertices and indices of every mesh, sub-allocated from a few large device-local buffers: a block is a vertex buffer,
+// a 32-bit index buffer and a storage buffer of the meshes' tables, the static data the GPU reads to cull and draw
+// them (e.g. their levels of detail and meshlets), registered in the bindless heap. A new block is created only when
+// no block has room for every range of a mesh. Meshes sharing a block are drawn after a single bind, which
+// multi-draw-indirect relies on. Vertices of any format can share a block: a vertex range is aligned to its stride so
+// that the base vertex is a whole number
+class GeometryPool {
+public:
+    GeometryPool(Device &device,
+                 UploadService &upload_service,
+                 BindlessHeap &bindless_heap,
+                 vk::DeviceSize vertex_block_size = g_default_geometry_vertex_block_size,
+                 vk::DeviceSize index_block_size = g_default_geometry_index_block_size,
+                 vk::DeviceSize table_block_size = g_default_geometry_table_block_size);
+
+    GeometryPool(const GeometryPool &) = delete;
+    GeometryPool &operator=(const GeometryPool &) = delete;
+    GeometryPool(GeometryPool &&) noexcept = delete;
+    GeometryPool &operator=(GeometryPool &&) noexcept = delete;
+
+    ~GeometryPool();
+
+    // copies the data into the pool through the upload service; the frame that draws it waits for the upload. The
+    // table is a whole number of `g_geometry_table_element_size` elements
+    [[nodiscard]] geometry_allocation_s allocate(std::span<const std::byte> vertices,
+                                                 vk::DeviceSize vertex_stride,
+                                                 std::span<const std::uint32_t> indices,
+                                                 std::span<const std::byte> table = {});
+
+    // the ranges are handed out again only once the frames recorded so far are completed
+    void release(const geometry_allocation_s &allocation);
+
+    void bind(vk::CommandBuffer command_buffer, std::uint32_t block_index) const noexcept;
+
+    [[nodiscard]] std::size_t block_count() const noexcept { return m_blocks.size(); }
+    // the storage buffer of the tables of the block, addressed by `geometry_allocation_s::first_table_element`
+    [[nodiscard]] bindless_id_t table_id(const std::uint32_t block_index) const noexcept {
+        return m_blocks[block_index].table_id;
+    }
+
+private:
+    struct block_s {
+        DeviceMemoryBuffer vertex_buffer;
+        DeviceMemoryBuffer index_buffer;
+        DeviceMemoryBuffer table_buffer;
+        bindless_id_t table_id = g_invalid_bindless_id;
+        // in bytes
+        util::RangeAllocator vertex_ranges;
+        // in indices
+        util::RangeAllocator index_ranges;
+        // in table elements
+        util::RangeAllocator table_ranges;
+    };
+
+    [[nodiscard]] bool try_allocate(block_s &block,
+                                    std::uint64_t vertex_size,
+                                    vk::DeviceSize vertex_stride,
+                                    std::uint64_t index_count,
+                                    std::uint64_t table_element_count,
+                                    geometry_allocation_s &allocation);
+    block_s &add_block(vk::DeviceSize min_vertex_size, vk::DeviceSize min_index_size, vk::DeviceSize min_table_size);
+    // frees the ranges of the released allocations whose frames are completed
+    void collect();
+
+    Device &m_device;
+    UploadService &m_upload_service;
+    BindlessHeap &m_bindless_heap;
+
+    vk::DeviceSize m_vertex_block_size;
+    vk::DeviceSize m_index_block_size;
+    vk::DeviceSize m_table_block_size;
+
+    std::vector<block_s> m_blocks;
+    // each with the frame that has to be completed before its ranges are handed out again
+    std::deque<std::pair<std::uint64_t, geometry_allocation_s>> m_released_allocations;
+};
+
+} // namespace sm::arcane::vulkan
@@ -0,0 +1,50 @@
+#include "growable_buffer.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace sm::arcane::vulkan {
+
+GrowableBuffer::GrowableBuffer(Device &device,
+                               BindlessHeap &bindless_heap,
+                               const vk::BufferUsageFlags usages,
+                               const vk::MemoryPropertyFlags memory_property_flags)
+    : m_device{device},
+      m_bindless_heap{bindless_heap},
+      m_usages{usages | vk::BufferUsageFlagBits::eStorageBuffer},
+      m_memory_property_flags{memory_property_flags} {}
+
+GrowableBuffer::GrowableBuffer(GrowableBuffer &&other) noexcept
+    : m_device{other.m_device},
+      m_bindless_heap{other.m_bindless_heap},
+      m_usages{other.m_usages},
+      m_memory_property_flags{other.m_memory_property_flags},
+      m_buffer{std::exchange(other.m_buffer, nullptr)},
+      m_size{std::exchange(other.m_size, 0)},
+      m_bindless_id{std::exchange(other.m_bindless_id, g_invalid_bindless_id)} {}
+
+GrowableBuffer::~GrowableBuffer() { release(); }
+
+void GrowableBuffer::reserve(const vk::DeviceSize size) {
+    if (size <= m_size) {
+        return;
+    }
+
+    const auto new_size = std::max({size, m_size + m_size / 2, g_min_growable_buffer_size});
+    release();
+    m_buffer = m_device.create_device_memory_buffer(m_usages, new_size, m_memory_property_flags);
+    m_size = new_size;
+    m_bindless_id = m_bindless_heap.register_storage_buffer(*m_buffer.buffer);
+}
+
+void GrowableBuffer::release() {
+    if (m_bindless_id == g_invalid_bindless_id) {
+        return;
+    }
+
+    m_bindless_heap.release_storage_buffer(std::exchange(m_bindless_id, g_invalid_bindless_id));
+    m_device.frame_scheduler().defer_destruction(std::exchange(m_buffer, nullptr));
+    m_size = 0;
+}
+
+} // namespace sm::arcane::vulkan
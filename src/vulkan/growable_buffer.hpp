@@ -0,0 +1,71 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "vulkan/bindless_heap.hpp"
+#include "vulkan/device.hpp"
+#include "vulkan/device_memory.hpp"
+
+namespace sm::arcane::vulkan {
+
+inline constexpr auto g_min_growable_buffer_size = vk::DeviceSize{64} * 1024;
+
+// A storage buffer registered in the bindless heap for arrays sized by the content, e.g. one element per object, which
+// no fixed budget fits. `reserve` recreates it larger whenever more is asked of it than it holds; the buffer it
+// replaces and that buffer's bindless id stay alive until the frames recorded so far are completed, since those may
+// still read them, and what they held is not carried over. Nothing is allocated before the first `reserve`
+class GrowableBuffer {
+public:
+    GrowableBuffer(Device &device,
+                   BindlessHeap &bindless_heap,
+                   vk::BufferUsageFlags usages,
+                   vk::MemoryPropertyFlags memory_property_flags = vk::MemoryPropertyFlagBits::eHostVisible |
+                                                                   vk::MemoryPropertyFlagBits::eHostCoherent);
+
+    GrowableBuffer(const GrowableBuffer &) = delete;
+    GrowableBuffer &operator=(const GrowableBuffer &) = delete;
+    GrowableBuffer(GrowableBuffer &&other) noexcept;
+    GrowableBuffer &operator=(GrowableBuffer &&) noexcept = delete;
+
+    ~GrowableBuffer();
+
+    // makes room for `size` bytes; the buffer grows by half at least, so content that grows a little every frame does
+    // not recreate it every frame
+    void reserve(vk::DeviceSize size);
+
+    [[nodiscard]] vk::Buffer buffer() const noexcept { return *m_buffer.buffer; }
+    [[nodiscard]] bindless_id_t bindless_id() const noexcept { return m_bindless_id; }
+    [[nodiscard]] vk::DeviceSize size() const noexcept { return m_size; }
+
+    // only for host-visible memory
+    template<typename T>
+    [[nodiscard]] std::span<T> mapped_span() const noexcept {
+        return m_buffer.mapped_span<T>();
+    }
+
+    // makes host writes visible to the device; only non-coherent memory types need it
+    void flush(const vk::DeviceSize offset = 0, const vk::DeviceSize range = vk::WholeSize) const {
+        m_buffer.flush(offset, range);
+    }
+
+private:
+    // hands the buffer and its id over to the frames that may still use them
+    void release();
+
+    Device &m_device;
+    BindlessHeap &m_bindless_heap;
+    vk::BufferUsageFlags m_usages;
+    vk::MemoryPropertyFlags m_memory_property_flags;
+
+    DeviceMemoryBuffer m_buffer = nullptr;
+    vk::DeviceSize m_size = 0;
+    bindless_id_t m_bindless_id = g_invalid_bindless_id;
+};
+
+} // namespace sm::arcane::vulkan
@@ -0,0 +1,176 @@
+#include "pipeline_cache.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <spdlog/logger.h>
+#include <spdlog/spdlog.h>
+
+namespace sm::arcane::vulkan {
+
+namespace {
+
+inline constexpr auto g_file_magic = std::uint32_t{0x43505241}; // "ARPC"
+inline constexpr auto g_file_format_version = std::uint32_t{1};
+
+// prepended to the driver's blob: the driver is not required to validate what it is fed, so we do it ourselves
+struct file_header_s {
+    std::uint32_t magic = g_file_magic;
+    std::uint32_t format_version = g_file_format_version;
+    std::uint32_t vendor_id = 0;
+    std::uint32_t device_id = 0;
+    std::uint32_t driver_version = 0;
+    std::array<std::uint8_t, VK_UUID_SIZE> pipeline_cache_uuid{};
+    std::uint64_t data_size = 0;
+    std::uint64_t data_checksum = 0;
+};
+
+[[nodiscard]] std::shared_ptr<spdlog::logger> logger() {
+    static const auto vulkan_logger = spdlog::default_logger()->clone("vulkan");
+    return vulkan_logger;
+}
+
+// FNV-1a
+[[nodiscard]] std::uint64_t checksum(const std::span<const std::byte> data) noexcept {
+    auto hash = std::uint64_t{0xcbf29ce484222325};
+    for (const auto byte : data) {
+        hash ^= static_cast<std::uint64_t>(byte);
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+[[nodiscard]] file_header_s make_file_header(const vk::PhysicalDeviceProperties &properties,
+                                             const std::span<const std::byte> data) noexcept {
+    auto header = file_header_s{.vendor_id = properties.vendorID,
+                                .device_id = properties.deviceID,
+                                .driver_version = properties.driverVersion,
+                                .data_size = data.size(),
+                                .data_checksum = checksum(data)};
+    std::memcpy(header.pipeline_cache_uuid.data(), properties.pipelineCacheUUID.data(), VK_UUID_SIZE);
+    return header;
+}
+
+[[nodiscard]] std::filesystem::path make_file_path(const std::filesystem::path &cache_dir,
+                                                   const vk::PhysicalDeviceProperties &properties) {
+    auto uuid = std::string{};
+    for (const auto byte : properties.pipelineCacheUUID) {
+        uuid += std::format("{:02x}", byte);
+    }
+    return cache_dir / std::format("pipeline_cache_{}_{:08x}.bin", uuid, properties.driverVersion);
+}
+
+// checks the header Vulkan itself puts in front of the blob (`VkPipelineCacheHeaderVersionOne`)
+[[nodiscard]] bool is_compatible_vulkan_header(const std::span<const std::byte> data,
+                                               const vk::PhysicalDeviceProperties &properties) noexcept {
+    auto header = VkPipelineCacheHeaderVersionOne{};
+    if (data.size() < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    return header.headerSize >= sizeof(header) && header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header.vendorID == properties.vendorID && header.deviceID == properties.deviceID &&
+           std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID.data(), VK_UUID_SIZE) == 0;
+}
+
+// an empty result means "start cold": a missing, stale or corrupted file is never an error
+[[nodiscard]] std::vector<std::byte> load_cache_data(const std::filesystem::path &file_path,
+                                                     const vk::PhysicalDeviceProperties &properties) {
+    auto file = std::ifstream{file_path, std::ios::binary};
+    if (!file.is_open()) {
+        return {};
+    }
+
+    auto header = file_header_s{};
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+        logger()->warn("Pipeline cache {}: truncated header, ignored", file_path.string());
+        return {};
+    }
+
+    const auto expected_header = make_file_header(properties, {});
+    if (header.magic != expected_header.magic || header.format_version != expected_header.format_version ||
+        header.vendor_id != expected_header.vendor_id || header.device_id != expected_header.device_id ||
+        header.driver_version != expected_header.driver_version ||
+        header.pipeline_cache_uuid != expected_header.pipeline_cache_uuid) {
+        logger()->warn("Pipeline cache {}: made by another device or driver, ignored", file_path.string());
+        return {};
+    }
+
+    // the declared size is only trusted once the file is known to hold that much: a truncated or corrupted file must
+    // start cold, not allocate whatever its header says
+    const auto data_offset = static_cast<std::streamoff>(file.tellg());
+    file.seekg(0, std::ios::end);
+    const auto file_end = static_cast<std::streamoff>(file.tellg());
+    file.seekg(data_offset);
+    if (!file || data_offset < 0 || file_end < data_offset ||
+        header.data_size != static_cast<std::uint64_t>(file_end - data_offset)) {
+        logger()->warn("Pipeline cache {}: truncated data, ignored", file_path.string());
+        return {};
+    }
+
+    auto data = std::vector<std::byte>(static_cast<std::size_t>(header.data_size));
+    if (!file.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(data.size())) ||
+        checksum(data) != header.data_checksum || !is_compatible_vulkan_header(data, properties)) {
+        logger()->warn("Pipeline cache {}: corrupted data, ignored", file_path.string());
+        return {};
+    }
+
+    return data;
+}
+
+} // namespace
+
+PipelineCache::PipelineCache(const vk::raii::PhysicalDevice &physical_device,
+                             const vk::raii::Device &device,
+                             const std::filesystem::path &cache_dir)
+    : m_properties{physical_device.getProperties()},
+      m_file_path{make_file_path(cache_dir, m_properties)},
+      m_pipeline_cache{nullptr} {
+    const auto data = load_cache_data(m_file_path, m_properties);
+    m_is_warm = !data.empty();
+
+    m_pipeline_cache = vk::raii::PipelineCache{device, vk::PipelineCacheCreateInfo{{}, data.size(), data.data()}};
+
+    logger()->info("Pipeline cache: {} ({})", m_file_path.string(), m_is_warm ? "warm" : "cold");
+}
+
+PipelineCache::~PipelineCache() {
+    try {
+        save();
+    } catch (const std::exception &e) {
+        // losing the cache only costs the next cold start, so it must not take the shutdown down
+        logger()->error("Failed to save the pipeline cache {}: {}", m_file_path.string(), e.what());
+    }
+}
+
+void PipelineCache::save() const {
+    const auto raw_data = m_pipeline_cache.getData();
+    const auto data = std::as_bytes(std::span{raw_data});
+    const auto header = make_file_header(m_properties, data);
+
+    std::filesystem::create_directories(m_file_path.parent_path());
+
+    auto temp_file_path = m_file_path;
+    temp_file_path += ".tmp";
+    {
+        auto file = std::ofstream{temp_file_path, std::ios::binary | std::ios::trunc};
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            throw std::runtime_error{std::format("Failed to write {}", temp_file_path.string())};
+        }
+    }
+    std::filesystem::rename(temp_file_path, m_file_path);
+}
+
+} // namespace sm::arcane::vulkan
@@ -0,0 +1,47 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <filesystem>
+
+#include <vulkan/vulkan_raii.hpp>
+
+namespace sm::arcane::vulkan {
+
+// The engine-wide `VkPipelineCache`, shared by every pipeline and persisted between runs.
+// The file lives under `cache_dir` and is named after the pipeline cache UUID and the driver version, so a driver
+// update or a different GPU starts from an empty cache instead of feeding the driver incompatible data. The blob is
+// also validated on load against our own file header (size and checksum) and the Vulkan cache header, and is written
+// back by `save` and on destruction
+class PipelineCache {
+public:
+    PipelineCache(const vk::raii::PhysicalDevice &physical_device,
+                  const vk::raii::Device &device,
+                  const std::filesystem::path &cache_dir);
+
+    PipelineCache(const PipelineCache &) = delete;
+    PipelineCache &operator=(const PipelineCache &) = delete;
+    PipelineCache(PipelineCache &&) noexcept = delete;
+    PipelineCache &operator=(PipelineCache &&) noexcept = delete;
+
+    ~PipelineCache();
+
+    [[nodiscard]] const vk::raii::PipelineCache &handle() const noexcept { return m_pipeline_cache; }
+    [[nodiscard]] const std::filesystem::path &file_path() const noexcept { return m_file_path; }
+
+    // whether the cache has been seeded from a valid file at startup
+    [[nodiscard]] bool is_warm() const noexcept { return m_is_warm; }
+
+    // serializes the cache; the file is replaced atomically, so a crash while saving never leaves a torn file
+    void save() const;
+
+private:
+    vk::PhysicalDeviceProperties m_properties;
+    std::filesystem::path m_file_path;
+    bool m_is_warm = false;
+
+    vk::raii::PipelineCache m_pipeline_cache;
+};
+
+} // namespace sm::arcane::vulkan
@@ -0,0 +1,203 @@
+#include "pipeline_registry.hpp"
+
+#include <array>
+#include <cstdint>
+#include <utility>
+
+#include "common/shaders/pipeline_functions.hpp"
+#include "util/hash.hpp"
+
+namespace sm::arcane::vulkan {
+
+namespace {
+
+[[nodiscard]] vk::raii::Pipeline create_pipeline(const vk::raii::Device &device,
+                                                 const vk::raii::PipelineCache &pipeline_cache,
+                                                 const graphics_pipeline_desc_s &desc) {
+    const auto vertex_shader_module = common::shaders::create_shader_module(
+            device,
+            common::shaders::read_spirv_file(desc.vertex_shader));
+    const auto fragment_shader_module = common::shaders::create_shader_module(
+            device,
+            common::shaders::read_spirv_file(desc.fragment_shader));
+
+    const auto shader_stages = std::array{
+            vk::PipelineShaderStageCreateInfo{{}, vk::ShaderStageFlagBits::eVertex, vertex_shader_module, "main"},
+            vk::PipelineShaderStageCreateInfo{{}, vk::ShaderStageFlagBits::eFragment, fragment_shader_module, "main"}};
+
+    const auto vertex_input_info = vk::PipelineVertexInputStateCreateInfo{{},
+                                                                          desc.vertex_bindings,
+                                                                          desc.vertex_attributes};
+
+    const auto input_assembly_state = vk::PipelineInputAssemblyStateCreateInfo{{}, desc.topology};
+
+    constexpr auto viewport_state = vk::PipelineViewportStateCreateInfo{{}, 1, nullptr, 1, nullptr};
+
+    const auto rasterization_state = vk::PipelineRasterizationStateCreateInfo{{},
+                                                                              false,
+                                                                              false,
+                                                                              desc.polygon_mode,
+                                                                              desc.cull_mode,
+                                                                              desc.front_face,
+                                                                              false,
+                                                                              0.0f,
+                                                                              0.0f,
+                                                                              0.0f,
+                                                                              1.0f};
+
+    constexpr auto multisampling = vk::PipelineMultisampleStateCreateInfo{{}, vk::SampleCountFlagBits::e1};
+
+    constexpr auto stencil_op_state = vk::StencilOpState{vk::StencilOp::eKeep,
+                                                         vk::StencilOp::eKeep,
+                                                         vk::StencilOp::eKeep,
+                                                         vk::CompareOp::eAlways};
+    const auto depth_stencil_state = vk::PipelineDepthStencilStateCreateInfo{{},
+                                                                             desc.depth_test,
+                                                                             desc.depth_write,
+                                                                             desc.depth_compare_op,
+                                                                             false,
+                                                                             false,
+                                                                             stencil_op_state,
+                                                                             stencil_op_state};
+
+    constexpr auto color_component_flags = vk::ColorComponentFlags{
+            vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG | vk::ColorComponentFlagBits::eB |
+            vk::ColorComponentFlagBits::eA};
+    const auto color_attachment_state = vk::PipelineColorBlendAttachmentState{desc.blend,
+                                                                              vk::BlendFactor::eSrcAlpha,
+                                                                              vk::BlendFactor::eOneMinusSrcAlpha,
+                                                                              vk::BlendOp::eAdd,
+                                                                              vk::BlendFactor::eOne,
+                                                                              vk::BlendFactor::eZero,
+                                                                              vk::BlendOp::eAdd,
+                                                                              color_component_flags};
+    const auto color_attachment_states = std::vector(desc.color_formats.size(), color_attachment_state);
+    const auto color_blend_state = vk::PipelineColorBlendStateCreateInfo{{},
+                                                                         false,
+                                                                         vk::LogicOp::eNoOp,
+                                                                         color_attachment_states,
+                                                                         {{1.0f, 1.0f, 1.0f, 1.0f}}};
+
+    constexpr auto dynamic_states = std::array{vk::DynamicState::eViewport, vk::DynamicState::eScissor};
+    const auto dynamic_state_info = vk::PipelineDynamicStateCreateInfo{{}, dynamic_states};
+
+    // no `stencilAttachmentFormat`: the passes attach only the depth aspect, even of a depth-stencil format
+    const auto rendering_create_info = vk::PipelineRenderingCreateInfoKHR{{}, desc.color_formats, desc.depth_format};
+
+    const auto pipeline_info = vk::GraphicsPipelineCreateInfo{{},
+                                                              shader_stages,
+                                                              &vertex_input_info,
+                                                              &input_assembly_state,
+                                                              nullptr,
+                                                              &viewport_state,
+                                                              &rasterization_state,
+                                                              &multisampling,
+                                                              &depth_stencil_state,
+                                                              &color_blend_state,
+                                                              &dynamic_state_info,
+                                                              desc.layout,
+                                                              {},
+                                                              {},
+                                                              {},
+                                                              {},
+                                                              &rendering_create_info};
+
+    return {device, pipeline_cache, pipeline_info};
+}
+
+[[nodiscard]] vk::raii::Pipeline create_pipeline(const vk::raii::Device &device,
+                                                 const vk::raii::PipelineCache &pipeline_cache,
+                                                 const compute_pipeline_desc_s &desc) {
+    const auto compute_shader_module = common::shaders::create_shader_module(
+            device,
+            common::shaders::read_spirv_file(desc.compute_shader));
+
+    const auto pipeline_info = vk::ComputePipelineCreateInfo{
+            {},
+            vk::PipelineShaderStageCreateInfo{{}, vk::ShaderStageFlagBits::eCompute, compute_shader_module, "main"},
+            desc.layout};
+
+    return {device, pipeline_cache, pipeline_info};
+}
+
+} // namespace
+
+std::size_t PipelineRegistry::desc_hash_s::operator()(const graphics_pipeline_desc_s &desc) const noexcept {
+    auto seed = std::hash<std::string>{}(desc.vertex_shader);
+    util::hash_combine(seed, desc.fragment_shader);
+    util::hash_combine(seed, static_cast<VkPipelineLayout>(desc.layout));
+    for (const auto &binding : desc.vertex_bindings) {
+        util::hash_combine(seed, binding.binding);
+        util::hash_combine(seed, binding.stride);
+        util::hash_combine(seed, binding.inputRate);
+    }
+    for (const auto &attribute : desc.vertex_attributes) {
+        util::hash_combine(seed, attribute.location);
+        util::hash_combine(seed, attribute.binding);
+        util::hash_combine(seed, attribute.format);
+        util::hash_combine(seed, attribute.offset);
+    }
+    util::hash_combine(seed, desc.topology);
+    util::hash_combine(seed, desc.polygon_mode);
+    util::hash_combine(seed, static_cast<VkCullModeFlags>(desc.cull_mode));
+    util::hash_combine(seed, desc.front_face);
+    util::hash_combine(seed, desc.depth_test);
+    util::hash_combine(seed, desc.depth_write);
+    util::hash_combine(seed, desc.depth_compare_op);
+    util::hash_combine(seed, desc.blend);
+    for (const auto format : desc.color_formats) {
+        util::hash_combine(seed, format);
+    }
+    util::hash_combine(seed, desc.depth_format);
+    return seed;
+}
+
+std::size_t PipelineRegistry::desc_hash_s::operator()(const compute_pipeline_desc_s &desc) const noexcept {
+    auto seed = std::hash<std::string>{}(desc.compute_shader);
+    util::hash_combine(seed, static_cast<VkPipelineLayout>(desc.layout));
+    return seed;
+}
+
+PipelineRegistry::PipelineRegistry(const Device &device, util::ThreadPool &thread_pool)
+    : m_device{device},
+      m_thread_pool{thread_pool} {}
+
+pipeline_t PipelineRegistry::register_pipeline(graphics_pipeline_desc_s desc) {
+    if (const auto it = m_pipelines.find(desc); it != m_pipelines.end()) {
+        return it->second;
+    }
+
+    const auto [it, _] = m_pipelines.emplace(std::move(desc), std::make_shared<vk::raii::Pipeline>(nullptr));
+    m_pending.push_back({&it->first, it->second});
+    return it->second;
+}
+
+pipeline_t PipelineRegistry::register_pipeline(compute_pipeline_desc_s desc) {
+    if (const auto it = m_compute_pipelines.find(desc); it != m_compute_pipelines.end()) {
+        return it->second;
+    }
+
+    const auto [it, _] = m_compute_pipelines.emplace(std::move(desc),
+                                                     std::make_shared<vk::raii::Pipeline>(nullptr));
+    m_pending.push_back({&it->first, it->second});
+    return it->second;
+}
+
+std::size_t PipelineRegistry::compile() {
+    // every job only reads its own description and writes its own pipeline; the pipeline cache is synchronized
+    // internally by the driver
+    m_thread_pool.parallel_for(m_pending.size(), [this](const std::size_t i) {
+        const auto &pending = m_pending[i];
+        std::visit(
+                [this, &pending](const auto *desc) {
+                    *pending.pipeline = create_pipeline(m_device.device(), m_device.pipeline_cache().handle(), *desc);
+                },
+                pending.desc);
+    });
+
+    const auto compiled_count = m_pending.size();
+    m_pending.clear();
+    return compiled_count;
+}
+
+} // namespace sm::arcane::vulkan
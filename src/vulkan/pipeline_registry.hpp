@@ -0,0 +1,103 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "util/thread_pool.hpp"
+#include "vulkan/device.hpp"
+
+namespace sm::arcane::vulkan {
+
+// The whole state of a graphics pipeline built with dynamic rendering. Viewport and scissor are always dynamic, the
+// rest is baked in; two equal descriptions always get the same pipeline from `PipelineRegistry`
+struct graphics_pipeline_desc_s {
+    // SPIR-V file names without the `.spv` extension, e.g. `draw_object.vert`
+    std::string vertex_shader;
+    std::string fragment_shader;
+    vk::PipelineLayout layout = nullptr;
+
+    std::vector<vk::VertexInputBindingDescription> vertex_bindings;
+    std::vector<vk::VertexInputAttributeDescription> vertex_attributes;
+    vk::PrimitiveTopology topology = vk::PrimitiveTopology::eTriangleList;
+
+    vk::PolygonMode polygon_mode = vk::PolygonMode::eFill;
+    vk::CullModeFlags cull_mode = vk::CullModeFlagBits::eNone;
+    vk::FrontFace front_face = vk::FrontFace::eCounterClockwise;
+
+    bool depth_test = true;
+    bool depth_write = true;
+    vk::CompareOp depth_compare_op = vk::CompareOp::eLessOrEqual;
+
+    // applied to every color attachment: classic "source over" alpha blending when enabled
+    bool blend = false;
+
+    std::vector<vk::Format> color_formats;
+    vk::Format depth_format = vk::Format::eUndefined;
+
+    [[nodiscard]] bool operator==(const graphics_pipeline_desc_s &other) const noexcept = default;
+};
+
+struct compute_pipeline_desc_s {
+    // a SPIR-V file name without the `.spv` extension, e.g. `cull_objects.comp`
+    std::string compute_shader;
+    vk::PipelineLayout layout = nullptr;
+
+    [[nodiscard]] bool operator==(const compute_pipeline_desc_s &other) const noexcept = default;
+};
+
+// a pipeline shared by every user of an equal description; it is empty until `PipelineRegistry::compile`
+using pipeline_t = std::shared_ptr<const vk::raii::Pipeline>;
+
+// Deduplicates pipelines by their full description and creates them in bulk: systems register what they need while
+// being constructed, then a single `compile` builds every new pipeline concurrently on the thread pool through the
+// engine-wide pipeline cache
+class PipelineRegistry {
+public:
+    PipelineRegistry(const Device &device, util::ThreadPool &thread_pool);
+
+    PipelineRegistry(const PipelineRegistry &) = delete;
+    PipelineRegistry &operator=(const PipelineRegistry &) = delete;
+    PipelineRegistry(PipelineRegistry &&) noexcept = delete;
+    PipelineRegistry &operator=(PipelineRegistry &&) noexcept = delete;
+
+    ~PipelineRegistry() = default;
+
+    [[nodiscard]] pipeline_t register_pipeline(graphics_pipeline_desc_s desc);
+    [[nodiscard]] pipeline_t register_pipeline(compute_pipeline_desc_s desc);
+
+    // creates every pipeline registered since the previous call; returns how many were created
+    std::size_t compile();
+
+    // the number of distinct pipelines
+    [[nodiscard]] std::size_t size() const noexcept { return m_pipelines.size() + m_compute_pipelines.size(); }
+
+private:
+    struct desc_hash_s {
+        [[nodiscard]] std::size_t operator()(const graphics_pipeline_desc_s &desc) const noexcept;
+        [[nodiscard]] std::size_t operator()(const compute_pipeline_desc_s &desc) const noexcept;
+    };
+
+    struct pending_s {
+        std::variant<const graphics_pipeline_desc_s *, const compute_pipeline_desc_s *> desc;
+        std::shared_ptr<vk::raii::Pipeline> pipeline;
+    };
+
+    const Device &m_device;
+    util::ThreadPool &m_thread_pool;
+
+    std::unordered_map<graphics_pipeline_desc_s, std::shared_ptr<vk::raii::Pipeline>, desc_hash_s> m_pipelines;
+    std::unordered_map<compute_pipeline_desc_s, std::shared_ptr<vk::raii::Pipeline>, desc_hash_s> m_compute_pipelines;
+    // the keys of an unordered map are never moved, so the pending entries can point at them
+    std::vector<pending_s> m_pending;
+};
+
+} // namespace sm::arcane::vulkan
@@ -19,8 +19,6 @@ public:
 
     [[nodiscard]] vk::SwapchainKHR handle() const noexcept { return *m_swapchain; }
     [[nodiscard]] const vk::raii::SwapchainKHR &get() const noexcept { return m_swapchain; }
-    [[nodiscard]] const vk::raii::CommandPool &command_pool() const noexcept { return m_command_pool; }
-    [[nodiscard]] const vk::raii::CommandBuffers &command_buffers() const noexcept { return m_command_buffers; }
     [[nodiscard]] const std::vector<vk::Image> &color_images() const noexcept { return m_color_images; }
     [[nodiscard]] vk::Format color_format() const noexcept { return m_color_format; }
     [[nodiscard]] vk::Format depth_format() const noexcept { return m_depth_dm_image.format; }
@@ -39,9 +37,6 @@ private:
     const Window &m_window;
     vk::SurfaceKHR m_surface;
 
-    vk::raii::CommandPool m_command_pool = nullptr;
-    vk::raii::CommandBuffers m_command_buffers = nullptr;
-
     vk::Extent2D m_extent;
     Swapchain *m_old_swapchain_ptr = nullptr;
     vk::raii::SwapchainKHR m_swapchain = nullptr;
@@ -51,7 +46,7 @@ private:
     std::vector<vk::raii::ImageView> m_image_views; // TODO: to do using VMA
     vk::Flags<vk::ImageUsageFlagBits> m_image_usages;
 
-    DeviceMemoryImage m_depth_dm_image = nullptr; // TODO: to do using VMA
+    DeviceMemoryImage m_depth_dm_image = nullptr;
 };
 
 } // namespace sm::arcane::vulkan
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include "upload_service.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace sm::arcane::vulkan {
+
+namespace {
+
+inline constexpr auto g_staging_alignment = vk::DeviceSize{16};
+
+[[nodiscard]] constexpr std::uint64_t align_up(const std::uint64_t value, const std::uint64_t alignment) noexcept {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+[[nodiscard]] vk::raii::Semaphore create_timeline_semaphore(const vk::raii::Device &device) {
+    const auto type_create_info = vk::SemaphoreTypeCreateInfo{vk::SemaphoreType::eTimeline, 0};
+    return {device, vk::SemaphoreCreateInfo{{}, &type_create_info}};
+}
+
+} // namespace
+
+UploadService::UploadService(const Device &device, const vk::DeviceSize staging_arena_size)
+    : m_device{device},
+      m_queue{device.queue_families().transfer.queue},
+      m_command_pool{device.device(),
+                     vk::CommandPoolCreateInfo{vk::CommandPoolCreateFlagBits::eTransient |
+                                                       vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
+                                               device.queue_families().transfer.index}},
+      m_timeline{create_timeline_semaphore(device.device())},
+      m_staging_arena{device.create_device_memory_buffer(vk::BufferUsageFlagBits::eTransferSrc, staging_arena_size)},
+      m_staging_arena_size{staging_arena_size},
+      m_staging_memory{m_staging_arena.mapped_span<std::byte>()} {
+    assert(m_staging_arena_size % g_staging_alignment == 0);
+}
+
+UploadService::~UploadService() {
+    try {
+        wait(m_submitted_value);
+    } catch (...) {
+        // the device is lost or already idle: there is nothing left to wait for
+    }
+}
+
+std::uint64_t UploadService::enqueue(const vk::Buffer dst_buffer,
+                                     vk::DeviceSize dst_offset,
+                                     std::span<const std::byte> data) {
+    while (!data.empty()) {
+        // data larger than the arena goes in arena-sized chunks; each chunk may end up in its own batch
+        const auto chunk_size = std::min<vk::DeviceSize>(data.size(), m_staging_arena_size);
+        const auto staging_offset = allocate_staging(chunk_size);
+        begin_batch_if_needed();
+
+        std::memcpy(m_staging_memory.data() + staging_offset, data.data(), chunk_size);
+        m_staging_arena.flush(staging_offset, chunk_size);
+        m_recording.command_buffer.copyBuffer(*m_staging_arena.buffer,
+                                              dst_buffer,
+                                              vk::BufferCopy{staging_offset, dst_offset, chunk_size});
+
+        dst_offset += chunk_size;
+        data = data.subspan(chunk_size);
+    }
+
+    // the value the batch being recorded will signal
+    return m_is_recording ? m_submitted_value + 1 : m_submitted_value;
+}
+
+std::uint64_t UploadService::submit() {
+    if (!m_is_recording) {
+        return m_submitted_value;
+    }
+
+    m_recording.command_buffer.end();
+    m_recording.value = ++m_submitted_value;
+    m_recording.staging_end = m_staging_head;
+
+    const auto command_buffer_info = vk::CommandBufferSubmitInfo{*m_recording.command_buffer};
+    const auto signal_semaphore_info = vk::SemaphoreSubmitInfo{*m_timeline,
+                                                               m_recording.value,
+                                                               vk::PipelineStageFlagBits2::eAllTransfer};
+    m_queue.submit2KHR(vk::SubmitInfo2{{}, nullptr, command_buffer_info, signal_semaphore_info});
+
+    m_in_flight.push_back(std::move(m_recording));
+    m_recording = batch_s{};
+    m_is_recording = false;
+
+    return m_submitted_value;
+}
+
+std::uint64_t UploadService::completed() const { return m_timeline.getCounterValue(); }
+
+void UploadService::wait(const std::uint64_t value) {
+    if (value > m_submitted_value) {
+        // the value belongs to the batch being recorded
+        submit();
+    }
+    if (value == 0 || is_completed(value)) {
+        retire_completed_batches();
+        return;
+    }
+
+    const auto wait_info = vk::SemaphoreWaitInfo{{}, 1, &*m_timeline, &value};
+    while (vk::Result::eTimeout ==
+           m_device.device().waitSemaphores(wait_info, std::numeric_limits<std::uint64_t>::max()))
+        ;
+
+    retire_completed_batches();
+}
+
+vk::DeviceSize UploadService::allocate_staging(const vk::DeviceSize size) {
+    assert(0 < size && size <= m_staging_arena_size);
+
+    for (;;) {
+        auto position = m_staging_head;
+        const auto offset = position % m_staging_arena_size;
+        if (offset + size > m_staging_arena_size) {
+            // the allocation doesn't fit before the end of the arena: skip the remainder and wrap around
+            position += m_staging_arena_size - offset;
+        }
+
+        if (position + size - m_staging_tail <= m_staging_arena_size) {
+            m_staging_head = align_up(position + size, g_staging_alignment);
+            return position % m_staging_arena_size;
+        }
+
+        // out of space: reclaim what the GPU has already consumed, otherwise make the pending copies retire-able and
+        // wait for the oldest batch
+        retire_completed_batches();
+        if (m_in_flight.empty() && !m_is_recording) {
+            // the arena is empty, restart it from the beginning
+            m_staging_head = m_staging_tail = align_up(m_staging_head, m_staging_arena_size);
+            continue;
+        }
+        submit();
+        wait_for_oldest_batch();
+    }
+}
+
+void UploadService::retire_completed_batches() {
+    const auto completed_value = completed();
+    while (!m_in_flight.empty() && m_in_flight.front().value <= completed_value) {
+        m_staging_tail = m_in_flight.front().staging_end;
+        m_free_command_buffers.push_back(std::move(m_in_flight.front().command_buffer));
+        m_in_flight.pop_front();
+    }
+}
+
+void UploadService::wait_for_oldest_batch() {
+    if (!m_in_flight.empty()) {
+        wait(m_in_flight.front().value);
+    }
+}
+
+void UploadService::begin_batch_if_needed() {
+    if (m_is_recording) {
+        return;
+    }
+
+    retire_completed_batches();
+    if (m_free_command_buffers.empty()) {
+        m_recording.command_buffer = std::move(
+                vk::raii::CommandBuffers{m_device.device(),
+                                         vk::CommandBufferAllocateInfo{*m_command_pool,
+                                                                       vk::CommandBufferLevel::ePrimary,
+                                                                       1}}
+                        .front());
+    } else {
+        m_recording.command_buffer = std::move(m_free_command_buffers.back());
+        m_free_command_buffers.pop_back();
+    }
+
+    // the pool is created with `eResetCommandBuffer`, so `begin` implicitly resets a recycled command buffer
+    m_recording.command_buffer.begin(vk::CommandBufferBeginInfo{vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+    m_is_recording = true;
+}
+
+} // namespace sm::arcane::vulkan
\ No newline at end of file
@@ -0,0 +1,98 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "vulkan/device.hpp"
+#include "vulkan/device_memory.hpp"
+
+namespace sm::arcane::vulkan {
+
+inline constexpr auto g_default_staging_arena_size = vk::DeviceSize{64} * 1024 * 1024;
+
+// Batches host -> device buffer copies into a single command buffer submitted on the transfer queue family (a
+// dedicated DMA queue when the device exposes one). The source data is copied into a persistently mapped ring arena,
+// so the caller's memory can be released right after `enqueue`. Completion is reported through a timeline semaphore:
+// every `enqueue` returns the value the batch containing it signals, the consumer waits on that value GPU-side (see
+// `Renderer::end_frame`) or CPU-side via `wait`. Not thread-safe: enqueue from the render thread only
+class UploadService {
+public:
+    explicit UploadService(const Device &device, vk::DeviceSize staging_arena_size = g_default_staging_arena_size);
+
+    UploadService(const UploadService &) = delete;
+    UploadService &operator=(const UploadService &) = delete;
+    UploadService(UploadService &&) noexcept = delete;
+    UploadService &operator=(UploadService &&) noexcept = delete;
+
+    ~UploadService();
+
+    // `dst_buffer` must have been created with `vk::BufferUsageFlagBits::eTransferDst`. Returns the timeline value the
+    // copy is complete at
+    [[nodiscard]] std::uint64_t enqueue(vk::Buffer dst_buffer,
+                                        vk::DeviceSize dst_offset,
+                                        std::span<const std::byte> data);
+
+    template<std::ranges::contiguous_range Range>
+    [[nodiscard]] std::uint64_t enqueue(const vk::Buffer dst_buffer,
+                                        const Range &data,
+                                        const vk::DeviceSize dst_offset = 0) {
+        return enqueue(dst_buffer, dst_offset, std::as_bytes(std::span{data}));
+    }
+
+    // submits the copies recorded so far; no-op if there are none. Returns the value of the last submitted batch
+    std::uint64_t submit();
+
+    [[nodiscard]] vk::Semaphore timeline() const noexcept { return *m_timeline; }
+    [[nodiscard]] std::uint64_t last_submitted() const noexcept { return m_submitted_value; }
+    [[nodiscard]] std::uint64_t completed() const;
+    [[nodiscard]] bool is_completed(const std::uint64_t value) const { return value <= completed(); }
+
+    // submits the pending batch if `value` belongs to it and blocks until the GPU has finished it
+    void wait(std::uint64_t value);
+
+private:
+    struct batch_s {
+        vk::raii::CommandBuffer command_buffer = nullptr;
+        std::uint64_t value = 0;
+        // the absolute ring position the batch's staging data ends at
+        std::uint64_t staging_end = 0;
+    };
+
+    // returns the arena offset of `size` contiguous bytes, retiring or waiting for the in-flight batches if needed
+    [[nodiscard]] vk::DeviceSize allocate_staging(vk::DeviceSize size);
+    void retire_completed_batches();
+    void wait_for_oldest_batch();
+    void begin_batch_if_needed();
+
+    const Device &m_device;
+    vk::raii::Queue m_queue;
+
+    vk::raii::CommandPool m_command_pool;
+    vk::raii::Semaphore m_timeline;
+
+    DeviceMemoryBuffer m_staging_arena;
+    vk::DeviceSize m_staging_arena_size;
+    std::span<std::byte> m_staging_memory;
+    // monotonic byte positions: `head` is where the next allocation starts, `tail` is where the oldest in-flight data
+    // starts; the arena offset is the position modulo the arena size
+    std::uint64_t m_staging_head = 0;
+    std::uint64_t m_staging_tail = 0;
+
+    batch_s m_recording;
+    bool m_is_recording = false;
+    std::deque<batch_s> m_in_flight;
+    std::vector<vk::raii::CommandBuffer> m_free_command_buffers;
+
+    std::uint64_t m_submitted_value = 0;
+};
+
+} // namespace sm::arcane::vulkan
\ No newline at end of file
@@ -45,14 +45,20 @@ VmaAllocationInfo Allocation::info() const {
     return info;
 }
 
-void Allocation::flush(const std::size_t offset, const std::size_t size) const {
-    if (!vmaFlushAllocation(m_allocator, m_handle, offset, size)) {
+vk::MemoryPropertyFlags Allocation::memory_property_flags() const noexcept {
+    auto flags = VkMemoryPropertyFlags{};
+    vmaGetAllocationMemoryProperties(m_allocator, m_handle, &flags);
+    return vk::MemoryPropertyFlags{flags};
+}
+
+void Allocation::flush(const vk::DeviceSize offset, const vk::DeviceSize size) const {
+    if (vmaFlushAllocation(m_allocator, m_handle, offset, size) != VK_SUCCESS) {
         throw std::runtime_error{"Failed to flush allocation"};
     }
 }
 
-void Allocation::invalidate(const std::size_t offset, const std::size_t size) const {
-    if (!vmaInvalidateAllocation(m_allocator, m_handle, offset, size)) {
+void Allocation::invalidate(const vk::DeviceSize offset, const vk::DeviceSize size) const {
+    if (vmaInvalidateAllocation(m_allocator, m_handle, offset, size) != VK_SUCCESS) {
         throw std::runtime_error{"Failed to invalidate allocation"};
     }
 }
@@ -5,6 +5,8 @@
 
 #include <concepts>
 #include <cstddef>
+#include <stdexcept>
+#include <utility>
 
 #include <vk_mem_alloc.h>
 #include <vulkan/vulkan_raii.hpp>
@@ -18,15 +20,30 @@ class Allocation {
 public:
     Allocation(VmaAllocator allocator, VmaAllocation handle) noexcept;
 
+    explicit(false) Allocation(std::nullptr_t) noexcept : m_allocator{nullptr}, m_handle{nullptr} {}
+
+    Allocation(const Allocation &) = delete;
+    Allocation &operator=(const Allocation &) = delete;
+
     Allocation(Allocation &&other) noexcept
         : m_allocator{std::exchange(other.m_allocator, nullptr)},
           m_handle{std::exchange(other.m_handle, nullptr)} {}
 
+    Allocation &operator=(Allocation &&other) noexcept {
+        if (this != &other) {
+            m_allocator = std::exchange(other.m_allocator, nullptr);
+            m_handle = std::exchange(other.m_handle, nullptr);
+        }
+        return *this;
+    }
+
     [[nodiscard]] VmaAllocationInfo info() const;
 
-    void flush(std::size_t offset = 0, std::size_t size = 0) const;
+    [[nodiscard]] vk::MemoryPropertyFlags memory_property_flags() const noexcept;
+
+    void flush(vk::DeviceSize offset = 0, vk::DeviceSize size = vk::WholeSize) const;
 
-    void invalidate(std::size_t offset = 0, std::size_t size = 0) const;
+    void invalidate(vk::DeviceSize offset = 0, vk::DeviceSize size = vk::WholeSize) const;
 
 private:
     template<typename Handle, typename Deleter>
@@ -44,6 +61,8 @@ public:
           m_handle{std::move(handle)},
           m_deleter{deleter} {}
 
+    explicit(false) AllocatedHandle(std::nullptr_t) noexcept : m_allocation{nullptr}, m_handle{}, m_deleter{} {}
+
     AllocatedHandle(AllocatedHandle &&other) noexcept
         : m_allocation{std::move(other.m_allocation)},
           m_handle{std::exchange(other.m_handle, Handle{})},
@@ -59,11 +78,21 @@ public:
         return *this;
     }
 
+    [[nodiscard]] Handle get() const noexcept { return m_handle; }
+    [[nodiscard]] Handle operator*() const noexcept { return m_handle; }
+    [[nodiscard]] explicit operator bool() const noexcept { return static_cast<bool>(m_handle); }
+
     [[nodiscard]] VmaAllocationInfo allocation_info() const { return m_allocation.info(); }
 
-    void flush(const std::size_t offset = 0, const std::size_t size = 0) const { m_allocation.flush(offset, size); }
+    [[nodiscard]] vk::MemoryPropertyFlags memory_property_flags() const noexcept {
+        return m_allocation.memory_property_flags();
+    }
+
+    void flush(const vk::DeviceSize offset = 0, const vk::DeviceSize size = vk::WholeSize) const {
+        m_allocation.flush(offset, size);
+    }
 
-    void invalidate(const std::size_t offset = 0, const std::size_t size = 0) const {
+    void invalidate(const vk::DeviceSize offset = 0, const vk::DeviceSize size = vk::WholeSize) const {
         m_allocation.invalidate(offset, size);
     }
 
@@ -105,15 +134,26 @@ class Allocator {
 public:
     Allocator(vk::Instance instance, vk::PhysicalDevice physical_device, vk::Device device);
 
-    [[nodiscard]] allocated_buffer_t allocate_buffer(const vk::BufferCreateInfo &buffer_create_info) {
+    Allocator(const Allocator &) = delete;
+    Allocator &operator=(const Allocator &) = delete;
+    Allocator(Allocator &&) = delete;
+    Allocator &operator=(Allocator &&) = delete;
+
+    [[nodiscard]] VmaAllocator handle() const noexcept { return m_allocator; }
+
+    [[nodiscard]] allocated_buffer_t allocate_buffer(
+            const vk::BufferCreateInfo &buffer_create_info,
+            const VmaAllocationCreateInfo &allocation_create_info = {.usage = VMA_MEMORY_USAGE_AUTO}) const {
         vk::Buffer buffer;
-        auto allocation = allocate_memory_and_create_handle(buffer_create_info, buffer);
+        auto allocation = allocate_memory_and_create_handle(buffer_create_info, allocation_create_info, buffer);
         return {std::move(allocation), buffer};
     }
 
-    [[nodiscard]] allocated_image_t allocate_image(const vk::ImageCreateInfo &image_create_info) {
+    [[nodiscard]] allocated_image_t allocate_image(
+            const vk::ImageCreateInfo &image_create_info,
+            const VmaAllocationCreateInfo &allocation_create_info = {.usage = VMA_MEMORY_USAGE_AUTO}) const {
         vk::Image image;
-        auto allocation = allocate_memory_and_create_handle(image_create_info, image);
+        auto allocation = allocate_memory_and_create_handle(image_create_info, allocation_create_info, image);
         return {std::move(allocation), image};
     }
 
@@ -121,10 +161,9 @@ public:
 
 private:
     template<typename Handle, typename HandleCreateInfo>
-    Allocation allocate_memory_and_create_handle(const HandleCreateInfo &create_info, Handle &handle) {
-        auto alloc_info = VmaAllocationCreateInfo{};
-        alloc_info.usage = VMA_MEMORY_USAGE_AUTO;
-
+    Allocation allocate_memory_and_create_handle(const HandleCreateInfo &create_info,
+                                                 const VmaAllocationCreateInfo &alloc_info,
+                                                 Handle &handle) const {
         VmaAllocation allocation;
         vk::Result allocate_result;
 
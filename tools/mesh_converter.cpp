@@ -0,0 +1,77 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+// Builds mesh cache files (see `primitive_graphics::MeshCache`) from OBJ models, offline:
+//     arcane_mesh_converter [--compact] [--overdraw] [--single-lod] <model.obj> <model.mesh>
+// A chain of levels of detail is simplified from the model first (`primitive_graphics::generate_lods`), unless
+// `--single-lod` is given.
+// The indices and vertices are reordered for the vertex cache and vertex fetches (`primitive_graphics::optimize_mesh`),
+// with `--overdraw` the triangles are also sorted to reduce overdraw. Last, every level is split into meshlets
+// (`primitive_graphics::build_meshlets`) for cluster culling
+
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+#include <spdlog/spdlog.h>
+
+#include "primitive_graphics/mesh_cache.hpp"
+#include "primitive_graphics/mesh_optimizer.hpp"
+#include "primitive_graphics/mesh_simplifier.hpp"
+#include "primitive_graphics/meshlet_builder.hpp"
+#include "primitive_graphics/obj_loader.hpp"
+
+int main(const int argc, char *argv[]) noexcept try {
+    namespace primitive_graphics = sm::arcane::primitive_graphics;
+
+    auto arguments = std::span{argv, static_cast<std::size_t>(argc)}.subspan(1);
+    auto vertex_format = primitive_graphics::vertex_format_e::full;
+    auto optimization_options = primitive_graphics::mesh_optimization_options_s{};
+    auto generates_lods = true;
+    while (!arguments.empty() && std::string_view{arguments.front()}.starts_with("--")) {
+        const auto option = std::string_view{arguments.front()};
+        arguments = arguments.subspan(1);
+        if (option == "--compact") {
+            vertex_format = primitive_graphics::vertex_format_e::compact;
+        } else if (option == "--overdraw") {
+            optimization_options.optimize_overdraw = true;
+        } else if (option == "--single-lod") {
+            generates_lods = false;
+        } else {
+            spdlog::critical("Unknown option {}", option);
+            return EXIT_FAILURE;
+        }
+    }
+    if (arguments.size() != 2) {
+        spdlog::critical(
+                "Usage: arcane_mesh_converter [--compact] [--overdraw] [--single-lod] <model.obj> <model.mesh>");
+        return EXIT_FAILURE;
+    }
+
+    const auto input_path = std::filesystem::path{arguments[0]};
+    const auto output_path = std::filesystem::path{arguments[1]};
+
+    auto mesh_data = primitive_graphics::load_obj(input_path);
+    if (generates_lods) {
+        primitive_graphics::generate_lods(mesh_data);
+    }
+    const auto report = primitive_graphics::optimize_mesh(mesh_data, optimization_options);
+    primitive_graphics::log_mesh_optimization_report(*spdlog::default_logger(), input_path.string(), report);
+    // after the optimization passes: clustering only reorders the triangles within each level
+    primitive_graphics::build_meshlets(mesh_data);
+    primitive_graphics::write_mesh_cache(output_path, mesh_data, vertex_format);
+
+    spdlog::info("{}: {} vertices, {} indices in {} levels of detail, {} meshlets -> {}",
+                 input_path.string(),
+                 mesh_data.vertices.size(),
+                 mesh_data.indices.size(),
+                 mesh_data.lods.size(),
+                 mesh_data.meshlets.size(),
+                 output_path.string());
+    return EXIT_SUCCESS;
+} catch (const std::exception &ex) {
+    spdlog::critical("Failed to convert the model. Reason: {}", ex.what());
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,187 @@
+// Arcane (https://github.com/stepanzorin/arcane)
+// Copyright Text: 2025 Stepan Zorin <stz.hom@gmail.com>
+
+// Measures the paths of `cameras::compute_matrices` against the matrices of `cameras::transform_object_s`, one object
+// at a time, over random transforms far from the world origin:
+//     arcane_transform_bench [object_count]
+// For every path, the best time of a few runs over the whole batch and the largest difference from the double precision
+// matrices of `transform_object_s` are logged. The AVX2 path is only run on a CPU that has it (see `util::simd_level`)
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <random>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <glm/fwd.hpp>
+#include <glm/gtx/quaternion.hpp>
+#include <glm/mat3x3.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <spdlog/spdlog.h>
+
+#include "cameras/transform.hpp"
+#include "cameras/transform_kernel.hpp"
+#include "util/cpu_features.hpp"
+
+namespace {
+
+namespace cameras = sm::arcane::cameras;
+namespace util = sm::arcane::util;
+
+constexpr auto g_default_object_count = std::size_t{100'000};
+constexpr auto g_run_count = 20;
+// where the objects are around, to measure what narrowing the positions relative to it loses
+constexpr auto g_origin = glm::f64vec3{1.0e6, -2.0e5, 3.0e4};
+
+// like the matrices of `objects::object_instance_s`
+struct matrices_s {
+    std::array<float, 16> model;
+    std::array<float, 12> normal;
+};
+
+struct transforms_s {
+    std::vector<glm::f64vec3> positions;
+    std::vector<glm::f32quat> orientations;
+    std::vector<glm::f32vec3> scales;
+};
+
+[[nodiscard]] transforms_s generate_transforms(const std::size_t object_count) {
+    auto random = std::mt19937{42};
+    auto offset = std::uniform_real_distribution{-500.0, 500.0};
+    auto component = std::normal_distribution{0.0f, 1.0f};
+    auto scale = std::uniform_real_distribution{0.1f, 4.0f};
+
+    auto transforms = transforms_s{};
+    transforms.positions.reserve(object_count);
+    transforms.orientations.reserve(object_count);
+    transforms.scales.reserve(object_count);
+    for (auto i = std::size_t{0}; i < object_count; ++i) {
+        transforms.positions.push_back(g_origin + glm::f64vec3{offset(random), offset(random), offset(random)});
+        const auto orientation = glm::f32quat{component(random), component(random), component(random),
+                                              component(random)};
+        transforms.orientations.push_back(glm::normalize(orientation));
+        transforms.scales.push_back({scale(random), scale(random), scale(random)});
+    }
+    return transforms;
+}
+
+[[nodiscard]] cameras::matrix_outputs_s to_outputs(std::vector<matrices_s> &matrices) noexcept {
+    auto *const first = reinterpret_cast<std::byte *>(matrices.data());
+    return {.model_matrices = first + offsetof(matrices_s, model),
+            .normal_matrices = first + offsetof(matrices_s, normal),
+            .stride = sizeof(matrices_s)};
+}
+
+// the matrices of `transform_object_s`, relative to `g_origin` like those of the batch
+void compute_reference(const transforms_s &transforms, std::vector<matrices_s> &matrices) noexcept {
+    for (auto i = std::size_t{0}; i < matrices.size(); ++i) {
+        auto transform = cameras::transform_object_s{};
+        transform.position = transforms.positions[i] - g_origin;
+        transform.orientation = transforms.orientations[i];
+        transform.scale = transforms.scales[i];
+
+        const auto model_matrix = glm::f32mat4{transform.model_matrix()};
+        const auto normal_matrix = transform.normal_matrix();
+        for (auto column = 0; column < 4; ++column) {
+            for (auto row = 0; row < 4; ++row) {
+                matrices[i].model[4 * column + row] = model_matrix[column][row];
+            }
+        }
+        for (auto column = 0; column < 3; ++column) {
+            for (auto row = 0; row < 3; ++row) {
+                matrices[i].normal[4 * column + row] = normal_matrix[column][row];
+            }
+            matrices[i].normal[4 * column + 3] = 0.0f;
+        }
+    }
+}
+
+[[nodiscard]] double best_run_milliseconds(const std::function<void()> &run) {
+    auto best = std::chrono::steady_clock::duration::max();
+    for (auto i = 0; i < g_run_count; ++i) {
+        const auto started_time = std::chrono::steady_clock::now();
+        run();
+        best = std::min(best, std::chrono::steady_clock::now() - started_time);
+    }
+    return std::chrono::duration<double, std::milli>(best).count();
+}
+
+[[nodiscard]] float max_difference(const std::vector<matrices_s> &matrices, const std::vector<matrices_s> &reference) {
+    auto difference = 0.0f;
+    for (auto i = std::size_t{0}; i < matrices.size(); ++i) {
+        for (auto j = std::size_t{0}; j < matrices[i].model.size(); ++j) {
+            difference = std::max(difference, std::abs(matrices[i].model[j] - reference[i].model[j]));
+        }
+        for (auto j = std::size_t{0}; j < matrices[i].normal.size(); ++j) {
+            difference = std::max(difference, std::abs(matrices[i].normal[j] - reference[i].normal[j]));
+        }
+    }
+    return difference;
+}
+
+} // namespace
+
+int main(const int argc, char *argv[]) noexcept try {
+    const auto arguments = std::span{argv, static_cast<std::size_t>(argc)}.subspan(1);
+    auto object_count = g_default_object_count;
+    if (arguments.size() > 1 ||
+        (arguments.size() == 1 &&
+         std::from_chars(arguments[0], arguments[0] + std::string_view{arguments[0]}.size(), object_count).ec !=
+                 std::errc{})) {
+        spdlog::critical("Usage: arcane_transform_bench [object_count]");
+        return EXIT_FAILURE;
+    }
+
+    const auto transforms = generate_transforms(object_count);
+    const auto batch = cameras::transform_batch_s{.positions = transforms.positions,
+                                                  .orientations = transforms.orientations,
+                                                  .scales = transforms.scales,
+                                                  .origin = g_origin};
+
+    auto reference = std::vector<matrices_s>(object_count);
+    const auto reference_milliseconds = best_run_milliseconds([&] { compute_reference(transforms, reference); });
+    spdlog::info("{} objects, SIMD level {}", object_count, util::to_string(util::simd_level()));
+    spdlog::info("transform_object_s: {:.3f} ms", reference_milliseconds);
+
+    auto matrices = std::vector<matrices_s>(object_count);
+    const auto outputs = to_outputs(matrices);
+    const auto measure = [&](const std::string_view name, const std::function<void()> &run) {
+        std::ranges::fill(matrices, matrices_s{});
+        const auto milliseconds = best_run_milliseconds(run);
+        spdlog::info("{}: {:.3f} ms, {:.1f}x, max difference {:.3g}",
+                     name,
+                     milliseconds,
+                     reference_milliseconds / milliseconds,
+                     max_difference(matrices, reference));
+    };
+
+    measure("scalar", [&] { cameras::detail::compute_matrices_scalar(batch, outputs, 0); });
+    measure("SSE2", [&] {
+        cameras::detail::compute_matrices_scalar(batch,
+                                                 outputs,
+                                                 cameras::detail::compute_matrices_sse2(batch, outputs));
+    });
+    if (util::simd_level() == util::simd_level_e::avx2) {
+        measure("AVX2", [&] {
+            cameras::detail::compute_matrices_scalar(batch,
+                                                     outputs,
+                                                     cameras::detail::compute_matrices_avx2(batch, outputs));
+        });
+    }
+    measure("compute_matrices", [&] { cameras::compute_matrices(batch, outputs); });
+    return EXIT_SUCCESS;
+} catch (const std::exception &ex) {
+    spdlog::critical("Failed to run the benchmark. Reason: {}", ex.what());
+    return EXIT_FAILURE;
+}